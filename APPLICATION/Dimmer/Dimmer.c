@@ -2,6 +2,8 @@
  * @file Dimmer.c
  * @author Mark Attia (markjosephattia@gmail.com)
  * @brief This is the implementation for the dimmer application
+ *        A table driven state machine keeps the lamp on while a door is open and for a delay
+ *        after the doors are closed, and turns it off when a door stays open too long
  * @version 0.1
  * @date 2020-04-06
  * 
@@ -12,23 +14,81 @@
 #include "Sched.h"
 #include "Rte.h"
 
+/* The lamp stays on for a while after the doors are closed and goes off if a door stays open too long */
+#define DIMMER_CLOSE_DELAY_MS           10000
+#define DIMMER_BATTERY_SAVER_MS         600000
+
+#define DIMMER_STATE_OFF                0
+#define DIMMER_STATE_ON                 1
+#define DIMMER_STATE_DELAY              2
+#define DIMMER_STATE_SAVER              3
+#define DIMMER_NUMBER_OF_STATES         4
+
+#define DIMMER_EVENT_DOOR_OPEN          0
+#define DIMMER_EVENT_DOOR_CLOSED        1
+#define DIMMER_EVENT_TIMEOUT            2
+#define DIMMER_NUMBER_OF_EVENTS         3
+
+typedef struct
+{
+    uint8_t lamp;
+    uint32_t timeoutMs;     /* The time the state times out after, 0 if it does not */
+    uint8_t next[DIMMER_NUMBER_OF_EVENTS];
+} dimmerState_t;
+
+/* The lamp fades out when it turns off as the Lighting fades to every new level */
+static const dimmerState_t Dimmer_states[DIMMER_NUMBER_OF_STATES] = {
+    /* DIMMER_STATE_OFF: the doors are closed */
+    {DIMMER_OFF, 0, {DIMMER_STATE_ON, DIMMER_STATE_OFF, DIMMER_STATE_OFF}},
+    /* DIMMER_STATE_ON: a door is open */
+    {DIMMER_ON, DIMMER_BATTERY_SAVER_MS, {DIMMER_STATE_ON, DIMMER_STATE_DELAY, DIMMER_STATE_SAVER}},
+    /* DIMMER_STATE_DELAY: the doors were just closed */
+    {DIMMER_ON, DIMMER_CLOSE_DELAY_MS, {DIMMER_STATE_ON, DIMMER_STATE_DELAY, DIMMER_STATE_OFF}},
+    /* DIMMER_STATE_SAVER: a door was left open */
+    {DIMMER_OFF, 0, {DIMMER_STATE_SAVER, DIMMER_STATE_OFF, DIMMER_STATE_SAVER}}
+};
+
+static uint8_t Dimmer_state = DIMMER_STATE_OFF;
+static uint8_t Dimmer_door = DOOR_CLOSED;
+static uint32_t Dimmer_deadline;
+
 /**
  * @brief This is the runnable for the Dimmer
+ *        It runs when the door contact changes or when the alarm of the state expires
+ *        and moves the state machine by the event that activated it
  * 
  */
-static void Dimmer_Runnable(void)
+void Dimmer_Runnable(void)
 {
-    uint8_t data;
-    Std_ReturnType error;
-    Rte_Call_DimmerReceiveData();
-    error = Rte_Read_DoorContact(&data);
-    if(data == DOOR_CLOSED && error == E_OK)
+    uint8_t door = Rte_IRead_DoorContactStatus();
+    uint8_t event = DIMMER_NUMBER_OF_EVENTS;
+    uint32_t now;
+    const dimmerState_t* state = &Dimmer_states[Dimmer_state];
+    Sched_GetTimeMs(&now);
+    if(door != Dimmer_door)
+    {
+        Dimmer_door = door;
+        event = (door == DOOR_OPEN) ? DIMMER_EVENT_DOOR_OPEN : DIMMER_EVENT_DOOR_CLOSED;
+    }
+    else if(state->timeoutMs && (sint32_t)(now - Dimmer_deadline) >= 0)
     {
-        Rte_Write_DimmerStatus(DIMMER_OFF);
+        event = DIMMER_EVENT_TIMEOUT;
     }
-    else if(data == DOOR_OPEN && error == E_OK)
+    if(event != DIMMER_NUMBER_OF_EVENTS)
     {
-        Rte_Write_DimmerStatus(DIMMER_ON);
+        Dimmer_state = state->next[event];
+        state = &Dimmer_states[Dimmer_state];
+        Rte_IWrite_DimmerStatus(state->lamp);
+        /* The timeout counts from the time of the event so it does not depend on the task period */
+        if(state->timeoutMs)
+        {
+            Dimmer_deadline = now + state->timeoutMs;
+            Rte_SetAlarm_Dimmer(Dimmer_deadline);
+        }
+        else
+        {
+            Rte_CancelAlarm_Dimmer();
+        }
     }
 }
 
@@ -41,6 +101,5 @@ static void Dimmer_Runnable(void)
  */
 Std_ReturnType Dimmer_Init(void)
 {
-    Std_ReturnType error = Rte_SetRunnableEntity(Dimmer_Runnable, RTE_DIMMER_RUNNABLE);
-    return error;
+    return E_OK;
 }
\ No newline at end of file
@@ -16,11 +16,19 @@
  * @brief This is the runnable for the Door Contact
  * 
  */
-static void DoorContact_Runnable(void)
+void DoorContact_Runnable(void)
 {
-    uint8_t leftStatus, rightStatus;
-    Rte_Read_LeftDoorStatus(&leftStatus);
-    Rte_Read_RightDoorStatus(&rightStatus);
+    static uint8_t leftStatus = DOOR_CLOSED, rightStatus = DOOR_CLOSED;
+    uint8_t status;
+    /* Every queued door change is taken, the last one is the current state */
+    while(Rte_Receive_LeftDoorStatus(&status) != RTE_E_NO_DATA)
+    {
+        leftStatus = status;
+    }
+    while(Rte_Receive_RightDoorStatus(&status) != RTE_E_NO_DATA)
+    {
+        rightStatus = status;
+    }
     if(leftStatus == DOOR_CLOSED && rightStatus == DOOR_CLOSED)
     {
         Rte_Write_DoorContactStatus(DOOR_CLOSED);
@@ -42,6 +50,5 @@ static void DoorContact_Runnable(void)
  */
 Std_ReturnType DoorContact_Init(void)
 {
-    Std_ReturnType error = Rte_SetRunnableEntity(DoorContact_Runnable, RTE_DOOR_CONTACT_RUNNABLE);
-    return error;
+    return E_OK;
 }
\ No newline at end of file
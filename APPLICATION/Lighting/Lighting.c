@@ -12,15 +12,24 @@
 #include "Sched.h"
 #include "Rte.h"
 
+/* No level was requested yet */
+#define LIGHTING_NO_LEVEL       0xFF
+
 /**
- * @brief This is the runnable for the lighting that sets the Lamp
+ * @brief This is the runnable for the lighting that sets the level the Lamp fades to
+ *        It runs when the dimmer changes and when the previous request returns,
+ *        a request refused because the previous one is pending is made again when that one returns
  * 
  */
-static void Lighting_Runnable(void)
+void Lighting_Runnable(void)
 {
-    uint8_t status;
-    Rte_Read_DimmerStatus(&status);
-    Rte_Call_LightingSetStatus(status);
+    static uint8_t lastLevel = LIGHTING_NO_LEVEL;
+    uint8_t level = (Rte_IRead_DimmerStatus() == DIMMER_ON) ? RTE_LAMP_LEVEL_MAX : 0;
+    Rte_Result_LightingSetLevel();
+    if(level != lastLevel && Rte_Call_LightingSetLevel(level) == E_OK)
+    {
+        lastLevel = level;
+    }
 }
 
 /**
@@ -32,6 +41,5 @@ static void Lighting_Runnable(void)
  */
 Std_ReturnType Lighting_Init(void)
 {
-    Std_ReturnType error = Rte_SetRunnableEntity(Lighting_Runnable, RTE_LIGHTING_RUNNABLE);
-    return error;
+    return E_OK;
 }
@@ -11,12 +11,15 @@
 #include "Std_Types.h"
 #include "Led.h"
 #include "Switch.h"
+#include "Uart_Cfg.h"
 #include "Uart.h"
 #include "Com.h"
+#include "Tp.h"
 #include "Sched.h"
 #include "LeftDoor.h"
 #include "RightDoor.h"
 #include "DoorContact.h"
+#include "ModeManager.h"
 #include "Dimmer.h"
 #include "Lighting.h"
 
@@ -25,11 +28,16 @@ static void App_Init(void)
 	Switch_Init();
 	Led_Init();
 	Uart_Init(9600, UART_ONE_STOP_BIT, UART_EVEN_PARITY);
+#if UART_LINK == UART_LINK_TP
+	Tp_Init();
+#else
 	Com_Init();
+#endif
 #ifdef FIRST_CONTROLLER_APP
 	LeftDoor_Init();
 	RightDoor_Init();
 	DoorContact_Init();
+	ModeManager_Init();
 #else
 	Dimmer_Init();
 	Lighting_Init();
@@ -0,0 +1,61 @@
+/**
+ * @file ModeManager.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the implementation for the Mode Manager
+ *        The vehicle runs while a door is open, stays in accessory for a while after the doors
+ *        are closed and then sleeps until a door is opened again
+ *        The door contact is followed at once and the sleep delay is checked by the slow task
+ * @version 0.1
+ * @date 2020-04-30
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#include "Std_Types.h"
+#include "Sched.h"
+#include "Rte.h"
+
+#define MODE_MANAGER_SLEEP_DELAY_MS     30000
+
+/* The scheduler time the doors were closed at */
+static uint32_t ModeManager_closedMs;
+
+/**
+ * @brief This is the runnable for the Mode Manager that follows the door contact
+ *        It runs when the door contact changes, and once at start up when the doors read closed
+ * 
+ */
+void ModeManager_Runnable(void)
+{
+    uint8_t status;
+    Rte_Read_DoorContactStatus(&status);
+    Sched_GetTimeMs(&ModeManager_closedMs);
+    Rte_Switch_VehicleMode((status == DOOR_OPEN) ? RTE_MODE_VEHICLE_MODE_RUN : RTE_MODE_VEHICLE_MODE_ACCESSORY);
+}
+
+/**
+ * @brief This is the runnable for the Mode Manager that puts the vehicle to sleep
+ *        It only runs in accessory, the delay is measured on the scheduler time so it does not depend on its period
+ * 
+ */
+void ModeManager_SleepRunnable(void)
+{
+    uint32_t now;
+    Sched_GetTimeMs(&now);
+    if(now - ModeManager_closedMs >= MODE_MANAGER_SLEEP_DELAY_MS)
+    {
+        Rte_Switch_VehicleMode(RTE_MODE_VEHICLE_MODE_SLEEP);
+    }
+}
+
+/**
+ * @brief Initialise the mode manager application
+ * 
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+Std_ReturnType ModeManager_Init(void)
+{
+    return E_OK;
+}
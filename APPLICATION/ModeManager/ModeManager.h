@@ -0,0 +1,23 @@
+/**
+ * @file ModeManager.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the user interface for the Mode Manager
+ * @version 0.1
+ * @date 2020-04-30
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#ifndef MODE_MANAGER_H
+#define MODE_MANAGER_H
+
+/**
+ * @brief Initialise the mode manager application
+ * 
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+extern Std_ReturnType ModeManager_Init(void);
+
+#endif
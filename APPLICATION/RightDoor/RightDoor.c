@@ -13,14 +13,32 @@
 #include "Rte.h"
 
 /**
- * @brief This is a function that checks the status of the door and sets it in the RTE
+ * @brief This is a function that takes the changes of the door and queues every change in the RTE
+ *        It runs when the request of the previous activation returns, which is once the door switch had an edge
  * 
  */
-static void RightDoor_Runnable(void)
+void RightDoor_Runnable(void)
 {
-    uint8_t status;
-    Rte_Call_RightDoorGetStatus(&status);
-    Rte_Write_RightDoorStatus(status);
+    static uint8_t lastStatus = DOOR_CLOSED;
+    static uint8_t status = DOOR_CLOSED;
+    uint8_t changed;
+    if(Rte_Result_RightDoorGetStatus(&changed) == E_OK)
+    {
+        status = changed;
+    }
+    if(status != lastStatus)
+    {
+        if(Rte_Send_RightDoorStatus(status) == E_OK)
+        {
+            lastStatus = status;
+        }
+        else
+        {
+            /* The queue is full so the change is sent again in the next activation */
+            Rte_Trigger_RightDoor();
+        }
+    }
+    Rte_Call_RightDoorGetStatus();
 }
 
 /**
@@ -32,6 +50,5 @@ static void RightDoor_Runnable(void)
  */
 Std_ReturnType RightDoor_Init(void)
 {
-    Std_ReturnType error = Rte_SetRunnableEntity(RightDoor_Runnable, RTE_RIGHT_DOOR_RUNNABLE);
-    return error;
+    return E_OK;
 }
\ No newline at end of file
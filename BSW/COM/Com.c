@@ -17,21 +17,48 @@
 #define COM_PDU_TRIGGERED                       0
 #define COM_PDU_NOT_TRIGGERED                   1
 
+/* The period of the Com task, a build may define another one to measure the latency of the link */
+#ifndef COM_TICK_TIME
 #define COM_TICK_TIME                           5
+#endif
 
 #define COM_BYTE_SIZE                           8
 
+#define COM_RX_NOT_ARMED                        0
+#define COM_RX_ARMED                            1
+
+#define COM_PDU_ENABLED                         0
+#define COM_PDU_DISABLED                        1
+
+/* A window of one second gives the bytes per second without a division */
+#define COM_STATS_WINDOW_TICKS                  (1000 / COM_TICK_TIME)
+#define COM_PERCENT                             100
+
 typedef struct
 {
     const PduInfoType* pduInf;
     uint16_t remainingTicks;
     uint16_t periodicTicks;
     uint8_t data[COM_PDU_SIZE_IN_BYTES+1];
+    uint8_t rxFrame[COM_PDU_SIZE_IN_BYTES];    /* The Uart receives in it, a complete frame is copied to data */
     uint8_t trig;
+    uint8_t rxArmed;
+    uint8_t enabled;
+    uint16_t timeoutTicks;
+    uint16_t silentTicks;   /* The ticks since the last valid received Pdu */
 }PduType;
 
 static volatile PduType Com_Pdu[COM_NUMBER_OF_PDUS];
 static volatile uint8_t Com_Signal[COM_NUMBER_OF_SIGNALS];
+/* Set by the Uart when the armed frame is complete */
+static volatile uint8_t Com_rxDone;
+
+static ComPduStatsType Com_PduStats[COM_NUMBER_OF_PDUS];
+static uint16_t Com_statsTicks;
+static uint32_t Com_windowTxBytes;
+static uint32_t Com_windowRxBytes;
+static uint16_t Com_txBytesPerSecond;
+static uint16_t Com_rxBytesPerSecond;
 
 const uint8_t Com_ByteMasks[COM_BYTE_SIZE] = {
     0b1,
@@ -46,8 +73,18 @@ const uint8_t Com_ByteMasks[COM_BYTE_SIZE] = {
 
 extern const PduInfoType PduInfo[COM_NUMBER_OF_PDUS];
 
+/**
+ * @brief Called by the Uart when the armed frame is complete
+ * 
+ */
+static void Com_RxDone(void)
+{
+    Com_rxDone = 1;
+}
+
 /**
  * @brief Initialises the Com
+ *        The Uart is set to find the first byte of a Pdu by COM_FRAME_START
  * 
  * @return Std_ReturnType 
  *                  E_OK
@@ -62,8 +99,14 @@ Std_ReturnType Com_Init(void)
         Com_Pdu[itr].remainingTicks = 0;
         Com_Pdu[itr].periodicTicks = Com_Pdu[itr].pduInf->triggerData / COM_TICK_TIME;
         Com_Pdu[itr].trig = COM_PDU_NOT_TRIGGERED;
+        Com_Pdu[itr].rxArmed = COM_RX_NOT_ARMED;
+        Com_Pdu[itr].enabled = COM_PDU_ENABLED;
+        Com_Pdu[itr].timeoutTicks = Com_Pdu[itr].pduInf->timeout / COM_TICK_TIME;
+        Com_Pdu[itr].silentTicks = 0;
     }
-    return E_OK;
+    Com_rxDone = 0;
+    Uart_SetRxCb(Com_RxDone);
+    return Uart_SetFrameStart(COM_FRAME_START);
 }
 
 /**
@@ -113,6 +156,165 @@ Std_ReturnType Com_TriggerTransmit(PduIdType pduId)
     return E_OK;
 }
 
+/**
+ * @brief Enables a Pdu
+ *        The Pdu is sent or received again from the next main function
+ * 
+ * @param pduId The Id of the Pdu
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Com_EnablePdu(PduIdType pduId)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(pduId < COM_NUMBER_OF_PDUS)
+    {
+        Com_Pdu[pduId].enabled = COM_PDU_ENABLED;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Disables a Pdu
+ *        The Pdu is neither sent nor received until it is enabled, it is used to silence the bus per mode
+ * 
+ * @param pduId The Id of the Pdu
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Com_DisablePdu(PduIdType pduId)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(pduId < COM_NUMBER_OF_PDUS)
+    {
+        Com_Pdu[pduId].enabled = COM_PDU_DISABLED;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Gets the load and the errors of the link
+ *        The rates are measured over the last complete second
+ * 
+ * @param stats The structure to fill
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Com_GetStats(ComStatsType* stats)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uartStats_t uartStats;
+    if(stats && Uart_GetStats(&uartStats) == E_OK)
+    {
+        stats->txBytesPerSecond = Com_txBytesPerSecond;
+        stats->rxBytesPerSecond = Com_rxBytesPerSecond;
+        stats->txBusLoad = 0;
+        stats->rxBusLoad = 0;
+        if(uartStats.baudRate)
+        {
+            stats->txBusLoad = (uint8_t)((uint32_t)Com_txBytesPerSecond * uartStats.frameBits * COM_PERCENT / uartStats.baudRate);
+            stats->rxBusLoad = (uint8_t)((uint32_t)Com_rxBytesPerSecond * uartStats.frameBits * COM_PERCENT / uartStats.baudRate);
+        }
+        stats->overrunErrors = uartStats.overrunErrors;
+        stats->framingErrors = uartStats.framingErrors;
+        stats->parityErrors = uartStats.parityErrors;
+        stats->discardedFrames = uartStats.discardedFrames;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Gets the counters of a Pdu
+ * 
+ * @param pduId The Id of the Pdu
+ * @param stats The structure to fill
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Com_GetPduStats(PduIdType pduId, ComPduStatsType* stats)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(stats && pduId < COM_NUMBER_OF_PDUS)
+    {
+        *stats = Com_PduStats[pduId];
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Hands a Pdu to the Uart and counts the result
+ * 
+ * @param pduId The Id of the Pdu
+ */
+static void Com_SendPdu(PduIdType pduId)
+{
+    if(Uart_Send((uint8_t*)Com_Pdu[pduId].data, COM_PDU_SIZE_IN_BYTES) == E_OK)
+    {
+        Com_PduStats[pduId].txCount++;
+    }
+    else
+    {
+        Com_PduStats[pduId].txDropped++;
+    }
+}
+
+/**
+ * @brief Checks the Pdu received since the last request and asks the Uart for the next one
+ *        The Uart drops the frames with line errors so only complete frames reach this point
+ *        A complete frame is copied to the data of the Pdu before the Uart is armed again
+ *        so the next frame cannot change it while it is checked and unpacked
+ * 
+ * @param pduId The Id of the Pdu
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK If a valid Pdu was received
+ *                  E_NOT_OK If there is nothing new to unpack
+ */
+static Std_ReturnType Com_ReceivePdu(PduIdType pduId)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t id;
+    uint8_t byteItr;
+    if(Com_Pdu[pduId].rxArmed == COM_RX_ARMED && Com_rxDone)
+    {
+        for(byteItr = 0; byteItr < COM_PDU_SIZE_IN_BYTES; byteItr++)
+        {
+            Com_Pdu[pduId].data[byteItr] = Com_Pdu[pduId].rxFrame[byteItr];
+        }
+        Com_rxDone = 0;
+        Com_Pdu[pduId].rxArmed = COM_RX_NOT_ARMED;
+        id = (Com_Pdu[pduId].data[COM_PDU_START>>3] >> (COM_PDU_START & 0x07)) & Com_ByteMasks[COM_PDU_WIDTH-1];
+        if(id == Com_Pdu[pduId].pduInf->id)
+        {
+            Com_PduStats[pduId].rxCount++;
+            Com_Pdu[pduId].silentTicks = 0;
+            error = E_OK;
+        }
+        else
+        {
+            Com_PduStats[pduId].rxInvalid++;
+        }
+    }
+    if(Com_Pdu[pduId].rxArmed == COM_RX_NOT_ARMED &&
+       Uart_Receive((uint8_t*)Com_Pdu[pduId].rxFrame, COM_PDU_SIZE_IN_BYTES) == E_OK)
+    {
+        Com_Pdu[pduId].rxArmed = COM_RX_ARMED;
+    }
+    return error;
+}
+
 /* WARNING : There is a restriction in the main function Algorithm
         A signal size must not exceed 1 Byte */
 
@@ -125,7 +327,7 @@ static void Com_MainFunctionTx(void)
     uint8_t pduItr, signalItr, byteItr;
     for(pduItr = 0; pduItr<COM_NUMBER_OF_PDUS; pduItr++)
     {
-        if(Com_Pdu[pduItr].pduInf->direction == PDU_SEND)
+        if(Com_Pdu[pduItr].pduInf->direction == PDU_SEND && Com_Pdu[pduItr].enabled == COM_PDU_ENABLED)
         {
             if(Com_Pdu[pduItr].pduInf->trig == PDU_TRIGGER_SIGNAL && Com_Pdu[pduItr].trig == COM_PDU_TRIGGERED)
             {
@@ -135,6 +337,7 @@ static void Com_MainFunctionTx(void)
 				}
                 Com_Pdu[pduItr].data[COM_PDU_START>>3] |= 
                                 Com_Pdu[pduItr].pduInf->id<<(COM_PDU_START & 0x07);
+                Com_Pdu[pduItr].data[0] |= COM_FRAME_START;
                 for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
                 {
                     /* The Byte Number |= signal << signalStart % 8 */
@@ -145,7 +348,7 @@ static void Com_MainFunctionTx(void)
 						Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]]>>(8-(Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07));
                 }
                 Com_Pdu[pduItr].trig = COM_PDU_NOT_TRIGGERED;
-                Uart_Send(Com_Pdu[pduItr].data, COM_PDU_SIZE_IN_BYTES);
+                Com_SendPdu(pduItr);
             }
             if(Com_Pdu[pduItr].pduInf->trig == PDU_TRIGGER_PERIOD && Com_Pdu[pduItr].remainingTicks == 0)
             {
@@ -155,6 +358,7 @@ static void Com_MainFunctionTx(void)
 				}
                 Com_Pdu[pduItr].data[COM_PDU_START>>3] |=
                                 Com_Pdu[pduItr].pduInf->id<<(COM_PDU_START & 0x07);
+                Com_Pdu[pduItr].data[0] |= COM_FRAME_START;
                 for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
                 {
                     /* The Byte Number |= signal << signalStart % 8 */
@@ -166,7 +370,7 @@ static void Com_MainFunctionTx(void)
 					Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]]>>(8-(Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07));
                 }
                 Com_Pdu[pduItr].remainingTicks = Com_Pdu[pduItr].periodicTicks;
-                Uart_Send(Com_Pdu[pduItr].data, COM_PDU_SIZE_IN_BYTES);
+                Com_SendPdu(pduItr);
             }
             if(Com_Pdu[pduItr].pduInf->trig == PDU_TRIGGER_PERIOD)
             {
@@ -185,29 +389,41 @@ static void Com_MainFunctionRx(void)
     uint8_t pduItr, signalItr;
     for(pduItr = 0; pduItr<COM_NUMBER_OF_PDUS; pduItr++)
     {
-        if(Com_Pdu[pduItr].pduInf->direction == PDU_RECEIVE)
+        if(Com_Pdu[pduItr].pduInf->direction == PDU_RECEIVE && Com_Pdu[pduItr].enabled == COM_PDU_ENABLED)
         {
             if(Com_Pdu[pduItr].pduInf->trig == PDU_TRIGGER_SIGNAL && Com_Pdu[pduItr].trig == COM_PDU_TRIGGERED)
             {
-                Uart_Receive(Com_Pdu[pduItr].data, COM_PDU_SIZE_IN_BYTES);
-                for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
+                if(Com_ReceivePdu(pduItr) == E_OK)
                 {
-                    /* Signal = data[start/8] >> signalStart % 8 */
-                    Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] = 
-                                (uint16_t)Com_Pdu[pduItr].data[Com_Pdu[pduItr].pduInf->signalStart[signalItr]>>3] >> (Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07);
-                    Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] &= Com_ByteMasks[Com_Pdu[pduItr].pduInf->signalWidth[signalItr]-1];
+                    for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
+                    {
+                        /* Signal = data[start/8] >> signalStart % 8 */
+                        Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] = 
+                                    (uint16_t)Com_Pdu[pduItr].data[Com_Pdu[pduItr].pduInf->signalStart[signalItr]>>3] >> (Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07);
+                        Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] &= Com_ByteMasks[Com_Pdu[pduItr].pduInf->signalWidth[signalItr]-1];
+                    }
+                    if(Com_Pdu[pduItr].pduInf->notification != NULL)
+                    {
+                        Com_Pdu[pduItr].pduInf->notification();
+                    }
                 }
                 Com_Pdu[pduItr].trig = COM_PDU_NOT_TRIGGERED;
             }
             if(Com_Pdu[pduItr].pduInf->trig == PDU_TRIGGER_PERIOD && Com_Pdu[pduItr].remainingTicks == 0)
             {
-                Uart_Receive(Com_Pdu[pduItr].data, COM_PDU_SIZE_IN_BYTES);
-                for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
+                if(Com_ReceivePdu(pduItr) == E_OK)
                 {
-                    /* Signal = data[start/8] >> signalStart % 8 */
-                    Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] = 
-                                (uint16_t)Com_Pdu[pduItr].data[Com_Pdu[pduItr].pduInf->signalStart[signalItr]>>3] >> (Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07);
-                    Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] &= Com_ByteMasks[Com_Pdu[pduItr].pduInf->signalWidth[signalItr]-1];
+                    for(signalItr = 0; signalItr<Com_Pdu[pduItr].pduInf->nSignals; signalItr++)
+                    {
+                        /* Signal = data[start/8] >> signalStart % 8 */
+                        Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] = 
+                                    (uint16_t)Com_Pdu[pduItr].data[Com_Pdu[pduItr].pduInf->signalStart[signalItr]>>3] >> (Com_Pdu[pduItr].pduInf->signalStart[signalItr] & 0x07);
+                        Com_Signal[Com_Pdu[pduItr].pduInf->signal[signalItr]] &= Com_ByteMasks[Com_Pdu[pduItr].pduInf->signalWidth[signalItr]-1];
+                    }
+                    if(Com_Pdu[pduItr].pduInf->notification != NULL)
+                    {
+                        Com_Pdu[pduItr].pduInf->notification();
+                    }
                 }
                 Com_Pdu[pduItr].remainingTicks = Com_Pdu[pduItr].periodicTicks;
             }
@@ -215,10 +431,38 @@ static void Com_MainFunctionRx(void)
             {
                 Com_Pdu[pduItr].remainingTicks--;
             }
+            /* The timeout is notified once until a valid Pdu is received again */
+            if(Com_Pdu[pduItr].silentTicks < Com_Pdu[pduItr].timeoutTicks)
+            {
+                Com_Pdu[pduItr].silentTicks++;
+                if(Com_Pdu[pduItr].silentTicks == Com_Pdu[pduItr].timeoutTicks && Com_Pdu[pduItr].pduInf->timeoutNotification != NULL)
+                {
+                    Com_Pdu[pduItr].pduInf->timeoutNotification();
+                }
+            }
         }
     }
 }
 
+/**
+ * @brief Statistics Runnable
+ *        Samples the Uart counters once per window
+ * 
+ */
+static void Com_MainFunctionStats(void)
+{
+    uartStats_t uartStats;
+    Com_statsTicks++;
+    if(Com_statsTicks == COM_STATS_WINDOW_TICKS && Uart_GetStats(&uartStats) == E_OK)
+    {
+        Com_statsTicks = 0;
+        Com_txBytesPerSecond = (uint16_t)(uartStats.txBytes - Com_windowTxBytes);
+        Com_rxBytesPerSecond = (uint16_t)(uartStats.rxBytes - Com_windowRxBytes);
+        Com_windowTxBytes = uartStats.txBytes;
+        Com_windowRxBytes = uartStats.rxBytes;
+    }
+}
+
 /**
  * @brief The Com Runnable
  * 
@@ -227,6 +471,7 @@ static void Com_Runnable(void)
 {
     Com_MainFunctionTx();
     Com_MainFunctionRx();
+    Com_MainFunctionStats();
 }
 
 const task_t Com_task = {&Com_Runnable, COM_TICK_TIME};
\ No newline at end of file
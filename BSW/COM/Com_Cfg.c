@@ -12,12 +12,29 @@
 #include "Com.h"
 #include "Com_Cfg.h"
 
+/* The RTE callbacks that pass the received door state and vehicle mode to the dimmer
+        and put the dimmer to sleep when the door ECU stops sending */
+extern void Rte_ComCbk_DoorPdu(void);
+extern void Rte_ComTimeout_DoorPdu(void);
+
+/* The door ECU sends the Pdu every COM_DOOR_PDU_PERIOD_MS while it is awake, a multiple of COM_TICK_TIME */
+#ifndef COM_DOOR_PDU_PERIOD_MS
+#define COM_DOOR_PDU_PERIOD_MS          5
+#endif
+#define COM_DOOR_PDU_TIMEOUT_MS         100
+
+/* The door ECU sends the door state and the dimmer ECU receives it */
+#ifdef FIRST_CONTROLLER_APP
+#define COM_DOOR_PDU_DIRECTION          PDU_SEND
+#else
+#define COM_DOOR_PDU_DIRECTION          PDU_RECEIVE
+#endif
+
 /* WARNING : There is a restriction in the main function Algorithm
         A signal size must not exceed 1 Byte */
 
 const PduInfoType PduInfo[COM_NUMBER_OF_PDUS] = {
-        /*      id           direction           nSignal            signal[]              signalStart[]          signalWidth[]                  trig                     triggerData            */
-        {    DOOR_PDU,       PDU_SEND,              1,         {DOOR_STATE_SIGNAL},             {0},                  {1},                PDU_TRIGGER_PERIOD,                 5                 }
-                            /* This will be changed to PDU_RECEIVE in the second micro controller */
+        /*      id           direction           nSignal            signal[]              signalStart[]          signalWidth[]                  trig                     triggerData            notification            timeout                     timeoutNotification     */
+        {    DOOR_PDU,       COM_DOOR_PDU_DIRECTION,              3,  {DOOR_STATE_SIGNAL, VEHICLE_MODE_SIGNAL, DOOR_SEQUENCE_SIGNAL},  {0, 1, 8},             {1, 2, 7},             PDU_TRIGGER_PERIOD,    COM_DOOR_PDU_PERIOD_MS,    Rte_ComCbk_DoorPdu,     COM_DOOR_PDU_TIMEOUT_MS,    Rte_ComTimeout_DoorPdu  }
 
 };
\ No newline at end of file
@@ -38,11 +38,35 @@ typedef struct
     uint8_t signalWidth[PDU_MAX_NUMBER_OF_SIGNALS];
     PduTriggerType trig;
     uint16_t triggerData; /* Milleseconds for Period and Signal Id for signal */
+    callback_t notification; /* Called after a received Pdu updated its signals, NULL for none */
+    uint16_t timeout; /* Milliseconds without a received Pdu before the timeout notification, 0 for none */
+    callback_t timeoutNotification; /* Called once when a received Pdu times out, NULL for none */
 
 }PduInfoType;
 
+typedef struct
+{
+    uint32_t txCount;
+    uint32_t rxCount;
+    uint32_t txDropped; /* The Uart was still sending the previous Pdu */
+    uint32_t rxInvalid; /* The received Pdu carried another Pdu Id */
+}ComPduStatsType;
+
+typedef struct
+{
+    uint16_t txBytesPerSecond;
+    uint16_t rxBytesPerSecond;
+    uint8_t txBusLoad; /* Percentage of the baud rate */
+    uint8_t rxBusLoad;
+    uint16_t overrunErrors;
+    uint16_t framingErrors;
+    uint16_t parityErrors;
+    uint16_t discardedFrames; /* Frames dropped by the Uart because of a line error */
+}ComStatsType;
+
 /**
  * @brief Initialises the Com
+ *        The Uart is set to find the first byte of a Pdu by COM_FRAME_START
  * 
  * @return Std_ReturnType 
  *                  E_OK
@@ -85,4 +109,52 @@ extern Std_ReturnType Com_ReceiveSignal(SignalIdType signalId, void* data);
  */
 extern Std_ReturnType Com_TriggerTransmit(PduIdType pduId);
 
+/**
+ * @brief Enables a Pdu
+ *        The Pdu is sent or received again from the next main function
+ * 
+ * @param pduId The Id of the Pdu
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Com_EnablePdu(PduIdType pduId);
+
+/**
+ * @brief Disables a Pdu
+ *        The Pdu is neither sent nor received until it is enabled, it is used to silence the bus per mode
+ * 
+ * @param pduId The Id of the Pdu
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Com_DisablePdu(PduIdType pduId);
+
+/**
+ * @brief Gets the load and the errors of the link
+ *        The rates are measured over the last complete second
+ * 
+ * @param stats The structure to fill
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Com_GetStats(ComStatsType* stats);
+
+/**
+ * @brief Gets the counters of a Pdu
+ * 
+ * @param pduId The Id of the Pdu
+ * @param stats The structure to fill
+ * 
+ * @return Std_ReturnType 
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Com_GetPduStats(PduIdType pduId, ComPduStatsType* stats);
+
 #endif
\ No newline at end of file
@@ -13,12 +13,18 @@
 #define COM_CFG_H_
 
 #define COM_NUMBER_OF_PDUS              1
-#define COM_NUMBER_OF_SIGNALS           1
-#define COM_PDU_START                   6
+#define COM_NUMBER_OF_SIGNALS           3
+#define COM_PDU_START                   5
 #define COM_PDU_WIDTH                   2
-#define COM_PDU_SIZE_IN_BYTES           1
+#define COM_PDU_SIZE_IN_BYTES           2
+
+/* The bit 7 of the first byte marks the start of a Pdu so the receiver finds the first byte again
+        after a lost byte, the signals must leave the bit 7 of every byte clear */
+#define COM_FRAME_START                 0x80
 
 #define DOOR_PDU                        0
 #define DOOR_STATE_SIGNAL               0
+#define DOOR_SEQUENCE_SIGNAL            1
+#define VEHICLE_MODE_SIGNAL             2
 
 #endif
\ No newline at end of file
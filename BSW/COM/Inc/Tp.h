@@ -0,0 +1,107 @@
+/**
+ * @file Tp.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the user interface for the Transport Protocol
+ *        It segments messages larger than one frame into a first frame followed by consecutive frames
+ *        and the data is streamed through the callbacks so the whole message is never buffered
+ * @version 0.1
+ * @date 2020-04-25
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#ifndef TP_H_
+#define TP_H_
+
+#define TP_MAX_MESSAGE_LENGTH               0x0FFF
+
+typedef Std_ReturnType (*tpTxCopy_t)(uint8_t* data, uint8_t length);
+typedef Std_ReturnType (*tpRxStart_t)(uint16_t length);
+typedef Std_ReturnType (*tpRxCopy_t)(const uint8_t* data, uint8_t length, uint16_t* available);
+typedef void (*tpNotify_t)(Std_ReturnType result);
+
+/**
+ * @brief Initialises the Transport Protocol
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_Init(void);
+
+/**
+ * @brief Starts the transmission of a message
+ *        The data is requested piece by piece through the Tx copy callback
+ *
+ * @param length The length of the message in bytes (1 to TP_MAX_MESSAGE_LENGTH)
+ *
+ * @return Std_ReturnType
+ *                  E_OK If the transmission is started
+ *                  E_NOT_OK If another transmission is in progress or the length is invalid
+ */
+extern Std_ReturnType Tp_Transmit(uint16_t length);
+
+/**
+ * @brief Sets the callback that fills the next piece of the message being sent
+ *        If the callback returns E_NOT_OK the data is requested again in the next tick,
+ *        the transmission is aborted if it is not given within TP_TIMEOUT_MS
+ *
+ * @param func the callback function
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_SetTxCopyCb(tpTxCopy_t func);
+
+/**
+ * @brief Sets the callback that is called when the transmission ends
+ *
+ * @param func the callback function
+ *              It receives E_OK once the last frame left the UART and E_NOT_OK if it was aborted
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_SetTxConfirmationCb(tpNotify_t func);
+
+/**
+ * @brief Sets the callback that is called when a new message starts to be received
+ *
+ * @param func the callback function
+ *              It receives the total length and returns E_NOT_OK to reject the message
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_SetRxStartCb(tpRxStart_t func);
+
+/**
+ * @brief Sets the callback that takes every received piece of the message
+ *        The callback saves in available the bytes it can take after this piece, a length of 0 only asks for them
+ *        The next block is only requested from the peer when the user can take all of it,
+ *        until then the peer is told to wait. Returning E_NOT_OK aborts the reception
+ *
+ * @param func the callback function
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_SetRxCopyCb(tpRxCopy_t func);
+
+/**
+ * @brief Sets the callback that is called when the reception ends
+ *
+ * @param func the callback function
+ *              It receives E_OK if the whole message was received and E_NOT_OK if it was aborted
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+extern Std_ReturnType Tp_SetRxIndicationCb(tpNotify_t func);
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file Tp_Cfg.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the configuration header for the Transport Protocol
+ * @version 0.1
+ * @date 2020-04-25
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef TP_CFG_H_
+#define TP_CFG_H_
+
+/* WARNING : The transport protocol uses the UART link on its own
+        It is scheduled instead of the Com task when UART_LINK is UART_LINK_TP in Uart_Cfg.h */
+
+#define TP_TICK_TIME                    5
+
+/* The size of every frame on the link (PCI + payload) */
+#define TP_FRAME_SIZE                   8
+
+/* The number of consecutive frames the peer may send before waiting for a flow control
+        0 means the whole message is sent without waiting
+        It can also be given on the command line with -DTP_BLOCK_SIZE=N */
+#ifndef TP_BLOCK_SIZE
+#define TP_BLOCK_SIZE                   8
+#endif
+
+/* The minimum separation time in milliseconds between consecutive frames sent by the peer */
+#define TP_ST_MIN_MS                    0
+
+/* The time in milliseconds to wait for the peer (a flow control or a consecutive frame),
+        for the user (the data of the next frame) or for the UART to send a frame */
+#define TP_TIMEOUT_MS                   1000
+
+/* While the user cannot take the next block a flow control WAIT is sent every TP_WAIT_MS,
+        which must be shorter than TP_TIMEOUT_MS of the peer
+        After TP_WAIT_MAX of them in a row the reception is aborted with a flow control OVERFLOW
+        and a sender aborts when it gets more than TP_WAIT_MAX in a row */
+#define TP_WAIT_MS                      250
+#define TP_WAIT_MAX                     8
+
+/* The value used to fill the unused bytes of a frame */
+#define TP_PADDING_BYTE                 0x00
+
+#endif
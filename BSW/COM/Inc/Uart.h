@@ -21,6 +21,18 @@
 typedef void (*txCb_t)(void);
 typedef void (*rxCb_t)(void);
 
+typedef struct
+{
+  uint32_t txBytes;
+  uint32_t rxBytes;
+  uint16_t overrunErrors;
+  uint16_t framingErrors;
+  uint16_t parityErrors;
+  uint16_t discardedFrames;
+  uint32_t baudRate;
+  uint8_t frameBits;
+} uartStats_t;
+
 /**
  * @brief Initializes the UART
  *
@@ -78,5 +90,28 @@ extern Std_ReturnType Uart_SetTxCb(txCb_t func);
  *                  E_NOT_OK: If the did not execute successfully
  */
 extern Std_ReturnType Uart_SetRxCb(rxCb_t func);
+/**
+ * @brief Sets the bits that mark the first byte of a received frame
+ *        A byte with one of these bits set starts the frame again and a byte without them is skipped
+ *        while no frame is started, so a receive armed in the middle of a frame waits for the next one
+ *        The other bytes of a frame must have these bits clear, 0 receives any bytes (the default)
+ *
+ * @param mask The bits of the first byte
+ * @return Std_ReturnType A Status
+ *                  E_OK: If the function executed successfully
+ *                  E_NOT_OK: If the did not execute successfully
+ */
+extern Std_ReturnType Uart_SetFrameStart(uint8_t mask);
+
+/**
+ * @brief Gets the traffic and error counters of the UART
+ *        The counters are only incremented so the user computes rates from the difference of two reads
+ *
+ * @param stats The structure to copy the counters to
+ * @return Std_ReturnType A Status
+ *                  E_OK: If the function executed successfully
+ *                  E_NOT_OK: If the did not execute successfully
+ */
+extern Std_ReturnType Uart_GetStats(uartStats_t* stats);
 
 #endif
@@ -0,0 +1,73 @@
+/**
+ * @file UartHost.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the user interface for the host backend of the UART driver
+ *        It connects the UART registers of a HOST_SIM build to a pseudo terminal or a UNIX socket
+ *        It only uses plain C types so it can be included next to the system headers
+ * @version 0.1
+ * @date 2020-04-27
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#ifndef UART_HOST_H
+#define UART_HOST_H
+
+#define UART_HOST_PTY                   0
+#define UART_HOST_SOCKET_CONNECT        1
+#define UART_HOST_SOCKET_LISTEN         2
+
+#define UART_HOST_OK                    0
+#define UART_HOST_NOT_OK                1
+
+#define UART_HOST_HUNG_UP               (-1)
+
+/**
+ * @brief Opens the link the UART is connected to
+ *
+ * @param mode The kind of link
+ *                 UART_HOST_PTY : Creates a pseudo terminal, path receives the name of its slave side
+ *                 UART_HOST_SOCKET_CONNECT : Connects to the UNIX socket at path
+ *                 UART_HOST_SOCKET_LISTEN : Listens on the UNIX socket at path, UartHost_Poll accepts one peer
+ * @param path The path of the socket or a buffer of at least 64 bytes for the pseudo terminal name
+ * @return int A Status
+ *                  UART_HOST_OK: If the link is open
+ *                  UART_HOST_NOT_OK: If the link could not be opened
+ */
+extern int UartHost_Open(int mode, char* path);
+
+/**
+ * @brief Closes the link
+ *
+ */
+extern void UartHost_Close(void);
+
+/**
+ * @brief Waits for the link and delivers its events to the UART interrupt handlers
+ *        Every received byte is put in UDR before calling the receive handler
+ *        and every transmitted byte calls the transmission complete handler
+ *        once the transmit buffer has room for the next byte, so the driver sends
+ *        as fast as the peer reads and no byte is dropped
+ *        When the peer hangs up the link is closed, a listening link then waits for the next peer
+ *
+ * @param timeoutMs The maximum time to wait for an event (-1 to wait forever)
+ * @return int The number of interrupts delivered or UART_HOST_HUNG_UP if the peer hung up
+ */
+extern int UartHost_Poll(int timeoutMs);
+
+/**
+ * @brief Takes a byte written by the driver to UDR and sends it on the link
+ *
+ * @param byte The written byte
+ */
+extern void UartHost_Write(unsigned char byte);
+
+/**
+ * @brief Gets the number of bytes dropped because the link could not take them
+ *        or its peer hung up before they were written
+ *
+ * @return unsigned long The number of dropped bytes
+ */
+extern unsigned long UartHost_GetDroppedBytes(void);
+
+#endif
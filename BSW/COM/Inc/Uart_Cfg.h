@@ -14,4 +14,24 @@
 
 #define UART_SYSTEM_CLK             8000000
 
+/* The layer that owns the UART link, only one of them can be scheduled
+   UART_LINK_COM : The Com task sends and receives the Pdus of Com_Cfg.c
+   UART_LINK_TP : The Tp task sends and receives segmented messages through Tp.h
+   It can also be given on the command line with -DUART_LINK=UART_LINK_TP */
+#define UART_LINK_COM               0
+#define UART_LINK_TP                1
+#ifndef UART_LINK
+#define UART_LINK                   UART_LINK_COM
+#endif
+
+/* The task of the layer that owns the UART link, Sched_Cfg.c schedules it */
+#if UART_LINK == UART_LINK_TP
+#define UART_LINK_TASK              Tp_task
+#else
+#define UART_LINK_TASK              Com_task
+#endif
+
+/* Define UART_HOST_BACKEND together with HOST_SIM in host builds to connect the UART
+        to a pseudo terminal or a UNIX socket through UartHost.c */
+
 #endif
\ No newline at end of file
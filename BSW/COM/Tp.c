@@ -0,0 +1,708 @@
+/**
+ * @file Tp.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the implementation for the Transport Protocol
+ * @version 0.1
+ * @date 2020-04-25
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Tp_Cfg.h"
+#include "Tp.h"
+#include "Uart.h"
+#include "Sched.h"
+#include "Reg_Access.h"
+
+#define SREG                                REG8(0x5F)
+
+#define GLOBAL_INT_DIS                      0x7F
+
+#define TP_PCI_SINGLE_FRAME                 0x00
+#define TP_PCI_FIRST_FRAME                  0x10
+#define TP_PCI_CONSECUTIVE_FRAME            0x20
+#define TP_PCI_FLOW_CONTROL                 0x30
+#define TP_PCI_TYPE_MASK                    0xF0
+#define TP_PCI_NIBBLE_MASK                  0x0F
+
+#define TP_FC_CONTINUE                      0x00
+#define TP_FC_WAIT                          0x01
+#define TP_FC_OVERFLOW                      0x02
+
+#define TP_SF_DATA_SIZE                     (TP_FRAME_SIZE - 1)
+#define TP_FF_DATA_SIZE                     (TP_FRAME_SIZE - 2)
+#define TP_CF_DATA_SIZE                     (TP_FRAME_SIZE - 1)
+
+#define TP_TIMEOUT_TICKS                    (TP_TIMEOUT_MS / TP_TICK_TIME)
+#define TP_WAIT_TICKS                       (TP_WAIT_MS / TP_TICK_TIME)
+
+/* The data of a block the user must be able to take before it is requested from the peer,
+        without blocks the peer sends the rest of the message at once */
+#if TP_BLOCK_SIZE
+#define TP_BLOCK_DATA_SIZE                  ((uint16_t)TP_BLOCK_SIZE * TP_CF_DATA_SIZE)
+#else
+#define TP_BLOCK_DATA_SIZE                  TP_MAX_MESSAGE_LENGTH
+#endif
+
+#define TP_IDLE                             0
+#define TP_TX_FIRST_FRAME                   1
+#define TP_TX_WAIT_FC                       2
+#define TP_TX_CONSECUTIVE_FRAME             3
+#define TP_TX_WAIT_CONFIRM                  4
+#define TP_RX_SEND_FC                       5
+#define TP_RX_WAIT_CF                       6
+#define TP_RX_SEND_OVERFLOW                 7
+
+#define TP_UART_IDLE                        0
+#define TP_UART_BUSY                        1
+
+typedef struct
+{
+    uint16_t length;
+    uint16_t remaining;
+    uint16_t timeoutTicks;
+    uint8_t blockSize;
+    uint8_t blockCount;
+    uint8_t stMinTicks;
+    uint8_t stMinRemaining;
+    uint8_t waitCount;
+    uint8_t waitTicks;
+    uint8_t sequence;
+    uint8_t state;
+} tpConnection_t;
+
+static tpConnection_t Tp_tx;
+static tpConnection_t Tp_rx;
+
+static uint8_t Tp_txFrame[TP_FRAME_SIZE];
+static uint8_t Tp_fcFrame[TP_FRAME_SIZE];
+static uint8_t Tp_rxFrame[2][TP_FRAME_SIZE];
+static uint8_t Tp_rxByte;
+
+static volatile uint8_t Tp_uartState;
+static volatile uint8_t Tp_rxBufferIdx;
+static volatile uint8_t Tp_rxReady;
+static volatile uint8_t Tp_rxPosition;
+/* The count of the received bytes, it wraps and is only compared between two ticks */
+static volatile uint8_t Tp_rxBytes;
+static uint8_t Tp_rxLastBytes;
+
+static tpTxCopy_t Tp_txCopy;
+static tpNotify_t Tp_txConfirmation;
+static tpRxStart_t Tp_rxStart;
+static tpRxCopy_t Tp_rxCopy;
+static tpNotify_t Tp_rxIndication;
+
+/**
+ * @brief Called by the UART when a whole frame is sent
+ *
+ */
+static void Tp_TxDone(void)
+{
+    Tp_uartState = TP_UART_IDLE;
+}
+
+/**
+ * @brief Called by the UART for every received byte
+ *        The frames are put together here so a frame cut by a lost byte can be dropped,
+ *        the next frame is received in the other buffer while a whole one is processed
+ *
+ */
+static void Tp_RxDone(void)
+{
+    Tp_rxFrame[Tp_rxBufferIdx][Tp_rxPosition] = Tp_rxByte;
+    Tp_rxBytes++;
+    if(++Tp_rxPosition == TP_FRAME_SIZE)
+    {
+        Tp_rxPosition = 0;
+        Tp_rxBufferIdx ^= 1;
+        Tp_rxReady = 1;
+    }
+    Uart_Receive(&Tp_rxByte, 1);
+}
+
+/**
+ * @brief Drops a frame that got no byte for a whole tick
+ *        The bytes of a frame follow each other on the line so such a frame lost a byte,
+ *        without this every following frame would start at the wrong byte
+ *
+ */
+static void Tp_RxResync(void)
+{
+    uint8_t sreg = SREG;
+    SREG = sreg & GLOBAL_INT_DIS;
+    if(Tp_rxPosition != 0 && Tp_rxBytes == Tp_rxLastBytes)
+    {
+        Tp_rxPosition = 0;
+    }
+    Tp_rxLastBytes = Tp_rxBytes;
+    SREG = sreg;
+}
+
+/**
+ * @brief Sends a frame if the UART is not sending another one
+ *
+ * @param frame The frame to send
+ * @return Std_ReturnType
+ *                  E_OK If the frame is being sent
+ *                  E_NOT_OK If the UART is busy
+ */
+static Std_ReturnType Tp_SendFrame(uint8_t* frame)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(Tp_uartState == TP_UART_IDLE)
+    {
+        Tp_uartState = TP_UART_BUSY;
+        error = Uart_Send(frame, TP_FRAME_SIZE);
+        if(error != E_OK)
+        {
+            Tp_uartState = TP_UART_IDLE;
+        }
+    }
+    return error;
+}
+
+/**
+ * @brief Fills the unused bytes of a frame
+ *
+ * @param frame The frame to pad
+ * @param start The first unused byte
+ */
+static void Tp_PadFrame(uint8_t* frame, uint8_t start)
+{
+    for(; start < TP_FRAME_SIZE; start++)
+    {
+        frame[start] = TP_PADDING_BYTE;
+    }
+}
+
+/**
+ * @brief Sends a flow control of the reception
+ *        The frame is only filled when the UART is free since it may still be sending the last one
+ *
+ * @param status TP_FC_CONTINUE, TP_FC_WAIT or TP_FC_OVERFLOW
+ * @return Std_ReturnType
+ *                  E_OK If the frame is being sent
+ *                  E_NOT_OK If the UART is busy
+ */
+static Std_ReturnType Tp_SendFlowControl(uint8_t status)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(Tp_uartState == TP_UART_IDLE)
+    {
+        Tp_fcFrame[0] = TP_PCI_FLOW_CONTROL | status;
+        Tp_fcFrame[1] = TP_BLOCK_SIZE;
+        Tp_fcFrame[2] = TP_ST_MIN_MS;
+        Tp_PadFrame(Tp_fcFrame, 3);
+        error = Tp_SendFrame(Tp_fcFrame);
+    }
+    return error;
+}
+
+/**
+ * @brief Ends the transmission and notifies the user
+ *
+ * @param result The result of the transmission
+ */
+static void Tp_EndTx(Std_ReturnType result)
+{
+    Tp_tx.state = TP_IDLE;
+    if(Tp_txConfirmation)
+    {
+        Tp_txConfirmation(result);
+    }
+}
+
+/**
+ * @brief Sends the filled frame of the transmission and moves it to its next state
+ *        The data of the frame was already taken from the user so the transmission is aborted if the UART refuses it
+ *
+ * @param state The state after the frame
+ */
+static void Tp_SendTxFrame(uint8_t state)
+{
+    if(Tp_SendFrame(Tp_txFrame) == E_OK)
+    {
+        Tp_tx.timeoutTicks = TP_TIMEOUT_TICKS;
+        Tp_tx.state = state;
+    }
+    else
+    {
+        Tp_EndTx(E_NOT_OK);
+    }
+}
+
+/**
+ * @brief Ends the reception and notifies the user
+ *
+ * @param result The result of the reception
+ */
+static void Tp_EndRx(Std_ReturnType result)
+{
+    Tp_rx.state = TP_IDLE;
+    if(Tp_rxIndication)
+    {
+        Tp_rxIndication(result);
+    }
+}
+
+/**
+ * @brief Drops the reception in progress for a new message, the user is only notified
+ *        if the reception was not already ended
+ *
+ */
+static void Tp_StopRx(void)
+{
+    if(Tp_rx.state == TP_RX_SEND_FC || Tp_rx.state == TP_RX_WAIT_CF)
+    {
+        Tp_EndRx(E_NOT_OK);
+    }
+    Tp_rx.state = TP_IDLE;
+}
+
+/**
+ * @brief Ends the reception with an error and tells the peer to stop sending
+ *
+ */
+static void Tp_OverflowRx(void)
+{
+    Tp_EndRx(E_NOT_OK);
+    Tp_rx.timeoutTicks = TP_TIMEOUT_TICKS;
+    Tp_rx.state = TP_RX_SEND_OVERFLOW;
+}
+
+/**
+ * @brief Handles a received single frame
+ *
+ * @param frame The received frame
+ */
+static void Tp_RxSingleFrame(const uint8_t* frame)
+{
+    uint8_t length = frame[0] & TP_PCI_NIBBLE_MASK;
+    uint16_t available;
+    if(length > 0 && length <= TP_SF_DATA_SIZE)
+    {
+        Tp_StopRx();
+        if(Tp_rxStart && Tp_rxCopy && Tp_rxStart(length) == E_OK)
+        {
+            Tp_EndRx(Tp_rxCopy(&frame[1], length, &available));
+        }
+    }
+}
+
+/**
+ * @brief Handles a received first frame
+ *
+ * @param frame The received frame
+ */
+static void Tp_RxFirstFrame(const uint8_t* frame)
+{
+    uint16_t length = ((uint16_t)(frame[0] & TP_PCI_NIBBLE_MASK) << 8) | frame[1];
+    uint16_t available;
+    if(length > TP_SF_DATA_SIZE)
+    {
+        Tp_StopRx();
+        Tp_rx.timeoutTicks = TP_TIMEOUT_TICKS;
+        if(Tp_rxStart && Tp_rxCopy && Tp_rxStart(length) == E_OK)
+        {
+            Tp_rx.length = length;
+            Tp_rx.remaining = length - TP_FF_DATA_SIZE;
+            Tp_rx.sequence = 1;
+            Tp_rx.blockCount = 0;
+            Tp_rx.waitCount = 0;
+            Tp_rx.waitTicks = TP_WAIT_TICKS;
+            Tp_rx.state = TP_RX_SEND_FC;
+            if(Tp_rxCopy(&frame[2], TP_FF_DATA_SIZE, &available) != E_OK)
+            {
+                Tp_OverflowRx();
+            }
+        }
+        else
+        {
+            Tp_rx.state = TP_RX_SEND_OVERFLOW;
+        }
+    }
+}
+
+/**
+ * @brief Handles a received consecutive frame
+ *
+ * @param frame The received frame
+ */
+static void Tp_RxConsecutiveFrame(const uint8_t* frame)
+{
+    uint8_t length;
+    uint16_t available;
+    if(Tp_rx.state == TP_RX_WAIT_CF)
+    {
+        length = Tp_rx.remaining > TP_CF_DATA_SIZE ? TP_CF_DATA_SIZE : (uint8_t)Tp_rx.remaining;
+        /* The user was asked for the room of the block before it was requested, a refused piece cannot be
+           kept since the peer does not stop before the end of the block */
+        if((frame[0] & TP_PCI_NIBBLE_MASK) == Tp_rx.sequence && Tp_rxCopy(&frame[1], length, &available) == E_OK)
+        {
+            Tp_rx.remaining -= length;
+            Tp_rx.sequence = (Tp_rx.sequence + 1) & TP_PCI_NIBBLE_MASK;
+            Tp_rx.timeoutTicks = TP_TIMEOUT_TICKS;
+            if(Tp_rx.remaining == 0)
+            {
+                Tp_EndRx(E_OK);
+            }
+            else if(TP_BLOCK_SIZE != 0 && ++Tp_rx.blockCount == TP_BLOCK_SIZE)
+            {
+                Tp_rx.blockCount = 0;
+                Tp_rx.waitCount = 0;
+                Tp_rx.waitTicks = TP_WAIT_TICKS;
+                Tp_rx.state = TP_RX_SEND_FC;
+            }
+        }
+        else
+        {
+            Tp_EndRx(E_NOT_OK);
+        }
+    }
+}
+
+/**
+ * @brief Handles a received flow control
+ *
+ * @param frame The received frame
+ */
+static void Tp_RxFlowControl(const uint8_t* frame)
+{
+    if(Tp_tx.state == TP_TX_WAIT_FC)
+    {
+        switch(frame[0] & TP_PCI_NIBBLE_MASK)
+        {
+            case TP_FC_CONTINUE:
+                Tp_tx.blockSize = frame[1];
+                Tp_tx.blockCount = 0;
+                Tp_tx.stMinTicks = (frame[2] + TP_TICK_TIME - 1) / TP_TICK_TIME;
+                Tp_tx.stMinRemaining = 0;
+                Tp_tx.timeoutTicks = TP_TIMEOUT_TICKS;
+                Tp_tx.state = TP_TX_CONSECUTIVE_FRAME;
+                break;
+            case TP_FC_WAIT:
+                if(++Tp_tx.waitCount > TP_WAIT_MAX)
+                {
+                    Tp_EndTx(E_NOT_OK);
+                }
+                else
+                {
+                    Tp_tx.timeoutTicks = TP_TIMEOUT_TICKS;
+                }
+                break;
+            default:
+                Tp_EndTx(E_NOT_OK);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Receive Runnable
+ *
+ */
+static void Tp_MainFunctionRx(void)
+{
+    const uint8_t* frame;
+    uint16_t available;
+    uint16_t needed;
+    Tp_RxResync();
+    if(Tp_rxReady)
+    {
+        Tp_rxReady = 0;
+        frame = Tp_rxFrame[Tp_rxBufferIdx ^ 1];
+        switch(frame[0] & TP_PCI_TYPE_MASK)
+        {
+            case TP_PCI_SINGLE_FRAME:
+                Tp_RxSingleFrame(frame);
+                break;
+            case TP_PCI_FIRST_FRAME:
+                Tp_RxFirstFrame(frame);
+                break;
+            case TP_PCI_CONSECUTIVE_FRAME:
+                Tp_RxConsecutiveFrame(frame);
+                break;
+            case TP_PCI_FLOW_CONTROL:
+                Tp_RxFlowControl(frame);
+                break;
+        }
+    }
+    switch(Tp_rx.state)
+    {
+        case TP_RX_SEND_FC:
+            /* The next block is requested once the user has room for it, until then the peer is told to wait */
+            needed = Tp_rx.remaining < TP_BLOCK_DATA_SIZE ? Tp_rx.remaining : TP_BLOCK_DATA_SIZE;
+            if(Tp_rxCopy(NULL, 0, &available) != E_OK)
+            {
+                Tp_OverflowRx();
+            }
+            else if(available >= needed)
+            {
+                if(Tp_SendFlowControl(TP_FC_CONTINUE) == E_OK)
+                {
+                    Tp_rx.timeoutTicks = TP_TIMEOUT_TICKS;
+                    Tp_rx.state = TP_RX_WAIT_CF;
+                }
+            }
+            else if(--Tp_rx.waitTicks == 0)
+            {
+                if(Tp_rx.waitCount == TP_WAIT_MAX)
+                {
+                    Tp_OverflowRx();
+                }
+                else if(Tp_SendFlowControl(TP_FC_WAIT) == E_OK)
+                {
+                    Tp_rx.waitCount++;
+                    Tp_rx.waitTicks = TP_WAIT_TICKS;
+                    Tp_rx.timeoutTicks = TP_TIMEOUT_TICKS;
+                }
+                else
+                {
+                    /* The UART is busy, tried again in the next tick */
+                    Tp_rx.waitTicks = 1;
+                }
+            }
+            break;
+        case TP_RX_SEND_OVERFLOW:
+            if(Tp_SendFlowControl(TP_FC_OVERFLOW) == E_OK)
+            {
+                Tp_rx.state = TP_IDLE;
+            }
+            break;
+    }
+    /* Every state waits at most TP_TIMEOUT_MS for the peer or the UART */
+    if(Tp_rx.state != TP_IDLE && --Tp_rx.timeoutTicks == 0)
+    {
+        if(Tp_rx.state == TP_RX_SEND_OVERFLOW)
+        {
+            Tp_rx.state = TP_IDLE;
+        }
+        else
+        {
+            Tp_EndRx(E_NOT_OK);
+        }
+    }
+}
+
+/**
+ * @brief Transmit Runnable
+ *
+ */
+static void Tp_MainFunctionTx(void)
+{
+    uint8_t length;
+    switch(Tp_tx.state)
+    {
+        case TP_TX_FIRST_FRAME:
+            if(Tp_uartState == TP_UART_IDLE)
+            {
+                if(Tp_tx.length <= TP_SF_DATA_SIZE)
+                {
+                    Tp_txFrame[0] = TP_PCI_SINGLE_FRAME | (uint8_t)Tp_tx.length;
+                    if(Tp_txCopy(&Tp_txFrame[1], (uint8_t)Tp_tx.length) == E_OK)
+                    {
+                        Tp_PadFrame(Tp_txFrame, Tp_tx.length + 1);
+                        Tp_SendTxFrame(TP_TX_WAIT_CONFIRM);
+                    }
+                }
+                else
+                {
+                    Tp_txFrame[0] = TP_PCI_FIRST_FRAME | (uint8_t)(Tp_tx.length >> 8);
+                    Tp_txFrame[1] = (uint8_t)Tp_tx.length;
+                    if(Tp_txCopy(&Tp_txFrame[2], TP_FF_DATA_SIZE) == E_OK)
+                    {
+                        Tp_tx.remaining = Tp_tx.length - TP_FF_DATA_SIZE;
+                        Tp_tx.sequence = 1;
+                        Tp_tx.waitCount = 0;
+                        Tp_SendTxFrame(TP_TX_WAIT_FC);
+                    }
+                }
+            }
+            break;
+        case TP_TX_WAIT_CONFIRM:
+            /* The last frame left the UART */
+            if(Tp_uartState == TP_UART_IDLE)
+            {
+                Tp_EndTx(E_OK);
+            }
+            break;
+        case TP_TX_CONSECUTIVE_FRAME:
+            if(Tp_tx.stMinRemaining)
+            {
+                Tp_tx.stMinRemaining--;
+            }
+            else if(Tp_uartState == TP_UART_IDLE)
+            {
+                length = Tp_tx.remaining > TP_CF_DATA_SIZE ? TP_CF_DATA_SIZE : (uint8_t)Tp_tx.remaining;
+                Tp_txFrame[0] = TP_PCI_CONSECUTIVE_FRAME | Tp_tx.sequence;
+                if(Tp_txCopy(&Tp_txFrame[1], length) == E_OK)
+                {
+                    Tp_PadFrame(Tp_txFrame, length + 1);
+                    Tp_tx.remaining -= length;
+                    Tp_tx.sequence = (Tp_tx.sequence + 1) & TP_PCI_NIBBLE_MASK;
+                    Tp_tx.stMinRemaining = Tp_tx.stMinTicks;
+                    if(Tp_tx.remaining == 0)
+                    {
+                        Tp_SendTxFrame(TP_TX_WAIT_CONFIRM);
+                    }
+                    else if(Tp_tx.blockSize != 0 && ++Tp_tx.blockCount == Tp_tx.blockSize)
+                    {
+                        Tp_tx.waitCount = 0;
+                        Tp_SendTxFrame(TP_TX_WAIT_FC);
+                    }
+                    else
+                    {
+                        Tp_SendTxFrame(TP_TX_CONSECUTIVE_FRAME);
+                    }
+                }
+            }
+            break;
+    }
+    /* Every state waits at most TP_TIMEOUT_MS for the user, the peer or the UART */
+    if(Tp_tx.state != TP_IDLE && --Tp_tx.timeoutTicks == 0)
+    {
+        Tp_EndTx(E_NOT_OK);
+    }
+}
+
+/**
+ * @brief Initialises the Transport Protocol
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_Init(void)
+{
+    Tp_tx.state = TP_IDLE;
+    Tp_rx.state = TP_IDLE;
+    Tp_uartState = TP_UART_IDLE;
+    Tp_rxReady = 0;
+    Tp_rxBufferIdx = 0;
+    Tp_rxPosition = 0;
+    Uart_SetTxCb(Tp_TxDone);
+    Uart_SetRxCb(Tp_RxDone);
+    /* The frames carry any bytes */
+    Uart_SetFrameStart(0);
+    return Uart_Receive(&Tp_rxByte, 1);
+}
+
+/**
+ * @brief Starts the transmission of a message
+ *        The data is requested piece by piece through the Tx copy callback
+ *
+ * @param length The length of the message in bytes (1 to TP_MAX_MESSAGE_LENGTH)
+ *
+ * @return Std_ReturnType
+ *                  E_OK If the transmission is started
+ *                  E_NOT_OK If another transmission is in progress or the length is invalid
+ */
+Std_ReturnType Tp_Transmit(uint16_t length)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(Tp_txCopy && Tp_tx.state == TP_IDLE && length > 0 && length <= TP_MAX_MESSAGE_LENGTH)
+    {
+        Tp_tx.length = length;
+        Tp_tx.timeoutTicks = TP_TIMEOUT_TICKS;
+        Tp_tx.state = TP_TX_FIRST_FRAME;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Sets the callback that fills the next piece of the message being sent
+ *        If the callback returns E_NOT_OK the data is requested again in the next tick,
+ *        the transmission is aborted if it is not given within TP_TIMEOUT_MS
+ *
+ * @param func the callback function
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_SetTxCopyCb(tpTxCopy_t func)
+{
+    Tp_txCopy = func;
+    return E_OK;
+}
+
+/**
+ * @brief Sets the callback that is called when the transmission ends
+ *
+ * @param func the callback function
+ *              It receives E_OK once the last frame left the UART and E_NOT_OK if it was aborted
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_SetTxConfirmationCb(tpNotify_t func)
+{
+    Tp_txConfirmation = func;
+    return E_OK;
+}
+
+/**
+ * @brief Sets the callback that is called when a new message starts to be received
+ *
+ * @param func the callback function
+ *              It receives the total length and returns E_NOT_OK to reject the message
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_SetRxStartCb(tpRxStart_t func)
+{
+    Tp_rxStart = func;
+    return E_OK;
+}
+
+/**
+ * @brief Sets the callback that takes every received piece of the message
+ *        The callback saves in available the bytes it can take after this piece, a length of 0 only asks for them
+ *        The next block is only requested from the peer when the user can take all of it,
+ *        until then the peer is told to wait. Returning E_NOT_OK aborts the reception
+ *
+ * @param func the callback function
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_SetRxCopyCb(tpRxCopy_t func)
+{
+    Tp_rxCopy = func;
+    return E_OK;
+}
+
+/**
+ * @brief Sets the callback that is called when the reception ends
+ *
+ * @param func the callback function
+ *              It receives E_OK if the whole message was received and E_NOT_OK if it was aborted
+ *
+ * @return Std_ReturnType
+ *                  E_OK
+ *                  E_NOT_OK
+ */
+Std_ReturnType Tp_SetRxIndicationCb(tpNotify_t func)
+{
+    Tp_rxIndication = func;
+    return E_OK;
+}
+
+/**
+ * @brief The Transport Protocol Runnable
+ *
+ */
+static void Tp_Runnable(void)
+{
+    Tp_MainFunctionRx();
+    Tp_MainFunctionTx();
+}
+
+const task_t Tp_task = {&Tp_Runnable, TP_TICK_TIME};
@@ -11,26 +11,38 @@
 #include "Std_Types.h"
 #include "Uart_Cfg.h"
 #include "Uart.h"
+#include "Reg_Access.h"
 
 typedef struct 
 {
   uint8_t *ptr;
   uint32_t pos;
   uint32_t size;
+  uint32_t skip;
   uint8_t state;
 } dataBuffer_t;
 
 typedef void (*appNotify_t)(void);
 
 
-#define UDR   (*(volatile uint8_t*)(0x2C))
-#define UBRRH (*(volatile uint8_t*)(0x40))
-#define UCSRC (*(volatile uint8_t*)(0x40))
-#define UCSRA (*(volatile uint8_t*)(0x2B))
-#define UCSRB (*(volatile uint8_t*)(0x2A))
-#define UBRRL (*(volatile uint8_t*)(0x29))
+#define UDR   REG8(0x2C)
+#define UBRRH REG8(0x40)
+#define UCSRC REG8(0x40)
+#define UCSRA REG8(0x2B)
+#define UCSRB REG8(0x2A)
+#define UBRRL REG8(0x29)
 
-#define SREG                        *((volatile uint8_t*)0x5F)
+#define SREG                        REG8(0x5F)
+
+#ifdef UART_HOST_BACKEND
+#include "UartHost.h"
+#define UART_WRITE_UDR(byte)        UartHost_Write(byte)
+#elif defined(HOST_SIM)
+#include "SimEcu.h"
+#define UART_WRITE_UDR(byte)        SimEcu_UartWrite(byte)
+#else
+#define UART_WRITE_UDR(byte)        (UDR = (byte))
+#endif
 #define GIE                         0x80
 
 #define UART_INT_NUMBER 37
@@ -50,12 +62,24 @@ typedef void (*appNotify_t)(void);
 
 #define UART_NO_PRESCALER 0x1
 
+#define UART_FRAMING_ERROR 0x10
+#define UART_DATA_OVERRUN  0x08
+#define UART_PARITY_ERROR  0x04
+#define UART_RX_ERRORS     (UART_FRAMING_ERROR | UART_DATA_OVERRUN | UART_PARITY_ERROR)
+
+#define UART_START_BIT     1
+#define UART_DATA_BITS     8
+
 static volatile dataBuffer_t txBuffer;
 static volatile dataBuffer_t rxBuffer;
 
 static volatile appNotify_t appTxNotify;
 static volatile appNotify_t appRxNotify;
 
+static volatile uint8_t rxFrameStart;
+
+static volatile uartStats_t uartStats;
+
 void __vector_13 (void) __attribute__ ((signal, used, externally_visible));
 void __vector_15 (void) __attribute__ ((signal, used, externally_visible));
 
@@ -65,10 +89,63 @@ void __vector_15 (void) __attribute__ ((signal, used, externally_visible));
  */
 void __vector_13 (void)
 {
+  /* The error flags belong to the byte in UDR so they must be read first */
+  uint8_t status = UCSRA;
+  /* UDR is always read to clear the interrupt even if no one is waiting for the data */
+  uint8_t data = UDR;
+  uartStats.rxBytes++;
+  if (status & UART_RX_ERRORS)
+  {
+    if (status & UART_DATA_OVERRUN)
+    {
+      uartStats.overrunErrors++;
+    }
+    if (status & UART_FRAMING_ERROR)
+    {
+      uartStats.framingErrors++;
+    }
+    if (status & UART_PARITY_ERROR)
+    {
+      uartStats.parityErrors++;
+    }
+  }
   if (UART_BUFFER_BUSY == rxBuffer.state) 
   {
-    rxBuffer.ptr[rxBuffer.pos] = UDR;
-    rxBuffer.pos++;
+    if (rxBuffer.skip)
+    {
+      rxBuffer.skip--;
+    }
+    else if (status & UART_RX_ERRORS)
+    {
+      /* The frame is dropped at once and the rest of it is skipped so the next frame starts at its first byte
+         An overrun already lost the byte before this one, with a frame start the next start byte is waited for */
+      rxBuffer.skip = rxFrameStart ? 0 : rxBuffer.size - rxBuffer.pos - 1;
+      if ((status & UART_DATA_OVERRUN) && rxBuffer.skip)
+      {
+        rxBuffer.skip--;
+      }
+      rxBuffer.pos = 0;
+      uartStats.discardedFrames++;
+    }
+    else if (data & rxFrameStart)
+    {
+      /* A frame cut short by a lost byte is dropped when the next one starts */
+      if (rxBuffer.pos)
+      {
+        uartStats.discardedFrames++;
+      }
+      rxBuffer.ptr[0] = data;
+      rxBuffer.pos = 1;
+    }
+    else if (rxFrameStart && !rxBuffer.pos)
+    {
+      /* The rest of a frame that started before the receive */
+    }
+    else
+    {
+      rxBuffer.ptr[rxBuffer.pos] = data;
+      rxBuffer.pos++;
+    }
 
     if (rxBuffer.pos == rxBuffer.size) 
     {
@@ -89,9 +166,10 @@ void __vector_13 (void)
  */
 void __vector_15 (void)
 {
+  uartStats.txBytes++;
   if (txBuffer.size != txBuffer.pos) 
   {
-    UDR = txBuffer.ptr[txBuffer.pos++];
+    UART_WRITE_UDR(txBuffer.ptr[txBuffer.pos++]);
   } 
   else 
   {
@@ -123,7 +201,6 @@ void __vector_15 (void)
  */
 extern Std_ReturnType Uart_Init(uint32_t baudRate, uint32_t stopBits, uint32_t parity) 
 {
-  uint8_t tmpReg;
   uint32_t baud = ((uint32_t)((f64)UART_SYSTEM_CLK / ((f64)baudRate * 16.0)));
   SREG |= GIE;
   UCSRB |= UART_RX_EN | UART_TX_EN;
@@ -132,6 +209,9 @@ extern Std_ReturnType Uart_Init(uint32_t baudRate, uint32_t stopBits, uint32_t p
   UCSRC = stopBits | UART_UCSRC_SELECT | UART_BYTE | parity;
   rxBuffer.state = UART_BUFFER_IDLE;
   txBuffer.state = UART_BUFFER_IDLE;
+  uartStats.baudRate = baudRate;
+  uartStats.frameBits = UART_START_BIT + UART_DATA_BITS + (stopBits == UART_TWO_STOP_BITS ? 2 : 1)
+                        + (parity == UART_NO_PARITY ? 0 : 1);
   UCSRB |= UART_RXCIE_SET | UART_TXCIE_SET;;
   return E_OK;
 }
@@ -155,7 +235,7 @@ Std_ReturnType Uart_Send(uint8_t *data, uint16_t length)
     txBuffer.pos = 0;
     txBuffer.size = length;
 
-    UDR = txBuffer.ptr[txBuffer.pos++];
+    UART_WRITE_UDR(txBuffer.ptr[txBuffer.pos++]);
     error = E_OK;
   }
   return error;
@@ -177,6 +257,7 @@ Std_ReturnType Uart_Receive(uint8_t *data, uint16_t length)
     rxBuffer.ptr = data;
     rxBuffer.size = length;
     rxBuffer.pos = 0;
+    rxBuffer.skip = 0;
     rxBuffer.state = UART_BUFFER_BUSY;
     error = E_OK;
   }
@@ -210,3 +291,43 @@ Std_ReturnType Uart_SetRxCb(rxCb_t func)
   appRxNotify = func;
   return E_OK;
 }
+/**
+ * @brief Sets the bits that mark the first byte of a received frame
+ *        A byte with one of these bits set starts the frame again and a byte without them is skipped
+ *        while no frame is started, so a receive armed in the middle of a frame waits for the next one
+ *        The other bytes of a frame must have these bits clear, 0 receives any bytes (the default)
+ *
+ * @param mask The bits of the first byte
+ * @return Std_ReturnType A Status
+ *                  E_OK: If the function executed successfully
+ *                  E_NOT_OK: If the did not execute successfully
+ */
+Std_ReturnType Uart_SetFrameStart(uint8_t mask)
+{
+  rxFrameStart = mask;
+  return E_OK;
+}
+/**
+ * @brief Gets the traffic and error counters of the UART
+ *        The counters are only incremented so the user computes rates from the difference of two reads
+ *
+ * @param stats The structure to copy the counters to
+ * @return Std_ReturnType A Status
+ *                  E_OK: If the function executed successfully
+ *                  E_NOT_OK: If the did not execute successfully
+ */
+Std_ReturnType Uart_GetStats(uartStats_t* stats)
+{
+  Std_ReturnType error = E_NOT_OK;
+  uint8_t sreg;
+  if (stats)
+  {
+    /* The counters are wider than a byte so the interrupts must not update them while copying */
+    sreg = SREG;
+    SREG &= ~GIE;
+    *stats = uartStats;
+    SREG = sreg;
+    error = E_OK;
+  }
+  return error;
+}
@@ -0,0 +1,384 @@
+/**
+ * @file UartHost.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the implementation for the host backend of the UART driver
+ *        It is only built with HOST_SIM and UART_HOST_BACKEND on Linux
+ *        Std_Types.h is not included because its fixed width types clash with the system headers
+ * @version 0.1
+ * @date 2020-04-27
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "UartHost.h"
+
+#define UART_HOST_UDR           0x2C
+#define UART_HOST_NAME_SIZE     64
+#define UART_HOST_RX_CHUNK      64
+#define UART_HOST_TX_SIZE       4096
+
+#define UART_HOST_NO_FD         (-1)
+
+extern volatile unsigned char Sim_registers[];
+
+void __vector_13 (void);
+void __vector_15 (void);
+
+static int hostFd = UART_HOST_NO_FD;
+static int hostPeerFd = UART_HOST_NO_FD;
+static int hostListenFd = UART_HOST_NO_FD;
+static int hostEpollFd = UART_HOST_NO_FD;
+
+static unsigned char hostTxBuffer[UART_HOST_TX_SIZE];
+static unsigned int hostTxHead;
+static unsigned int hostTxTail;
+static unsigned int hostTxComplete;
+static unsigned long hostDropped;
+
+/**
+ * @brief Makes a file descriptor non blocking
+ *
+ * @param fd The file descriptor
+ * @return int UART_HOST_OK or UART_HOST_NOT_OK
+ */
+static int UartHost_SetNonBlocking(int fd)
+{
+  int flags = fcntl(fd, F_GETFL, 0);
+  int error = UART_HOST_NOT_OK;
+  if (flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0)
+  {
+    error = UART_HOST_OK;
+  }
+  return error;
+}
+
+/**
+ * @brief Creates a pseudo terminal in raw mode
+ *
+ * @param path Receives the name of the slave side
+ * @return int The master file descriptor or UART_HOST_NO_FD
+ */
+static int UartHost_OpenPty(char* path)
+{
+  struct termios tio;
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd >= 0)
+  {
+    if (grantpt(fd) == 0 && unlockpt(fd) == 0 && ptsname_r(fd, path, UART_HOST_NAME_SIZE) == 0)
+    {
+      /* The slave is kept open so the master does not see a hang up while no peer is attached */
+      hostPeerFd = open(path, O_RDWR | O_NOCTTY);
+      if (hostPeerFd >= 0 && tcgetattr(hostPeerFd, &tio) == 0)
+      {
+        cfmakeraw(&tio);
+        tcsetattr(hostPeerFd, TCSANOW, &tio);
+      }
+    }
+    else
+    {
+      close(fd);
+      fd = UART_HOST_NO_FD;
+    }
+  }
+  return fd;
+}
+
+/**
+ * @brief Connects to a UNIX socket or listens on it
+ *        A listening socket is non blocking, its peer is accepted by UartHost_Poll
+ *
+ * @param path The path of the socket
+ * @param listening Non zero to listen for a peer
+ * @return int The connected or listening file descriptor or UART_HOST_NO_FD
+ */
+static int UartHost_OpenSocket(const char* path, int listening)
+{
+  struct sockaddr_un addr;
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  int error = UART_HOST_NOT_OK;
+  if (fd >= 0 && strlen(path) < sizeof(addr.sun_path))
+  {
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (listening)
+    {
+      unlink(path);
+      if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0 && listen(fd, 1) == 0)
+      {
+        error = UartHost_SetNonBlocking(fd);
+      }
+    }
+    else if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0)
+    {
+      error = UART_HOST_OK;
+    }
+  }
+  if (fd >= 0 && error != UART_HOST_OK)
+  {
+    close(fd);
+    fd = UART_HOST_NO_FD;
+  }
+  return fd;
+}
+
+/**
+ * @brief Gets the number of bytes the transmit buffer can still take
+ *
+ * @return unsigned int The free bytes
+ */
+static unsigned int UartHost_TxFree(void)
+{
+  return (hostTxTail + UART_HOST_TX_SIZE - hostTxHead - 1) % UART_HOST_TX_SIZE;
+}
+
+/**
+ * @brief Accepts a peer on the listening socket
+ *        Only one peer is served, another one is closed at once
+ *
+ */
+static void UartHost_Accept(void)
+{
+  struct epoll_event event;
+  int fd = accept4(hostListenFd, NULL, NULL, SOCK_NONBLOCK);
+  if (fd >= 0)
+  {
+    event.data.fd = fd;
+    event.events = EPOLLIN | (hostTxHead != hostTxTail ? EPOLLOUT : 0);
+    if (hostFd == UART_HOST_NO_FD && epoll_ctl(hostEpollFd, EPOLL_CTL_ADD, fd, &event) == 0)
+    {
+      hostFd = fd;
+    }
+    else
+    {
+      close(fd);
+    }
+  }
+}
+
+/**
+ * @brief Closes the link after its peer hung up
+ *        The bytes that were not written are dropped, a listening socket waits for the next peer
+ *
+ */
+static void UartHost_HangUp(void)
+{
+  epoll_ctl(hostEpollFd, EPOLL_CTL_DEL, hostFd, NULL);
+  close(hostFd);
+  hostFd = UART_HOST_NO_FD;
+  hostDropped += (hostTxHead + UART_HOST_TX_SIZE - hostTxTail) % UART_HOST_TX_SIZE;
+  hostTxTail = hostTxHead;
+}
+
+/**
+ * @brief Writes the queued bytes that the link can take now
+ *
+ */
+static void UartHost_Flush(void)
+{
+  ssize_t written;
+  unsigned int length;
+  struct epoll_event event;
+  /* Without a peer the bytes wait in the buffer, a listening link sends them once its peer connects */
+  if (hostFd == UART_HOST_NO_FD)
+  {
+    return;
+  }
+  while (hostTxHead != hostTxTail)
+  {
+    length = (hostTxHead > hostTxTail ? hostTxHead : UART_HOST_TX_SIZE) - hostTxTail;
+    written = write(hostFd, &hostTxBuffer[hostTxTail], length);
+    if (written <= 0)
+    {
+      break;
+    }
+    hostTxTail = (hostTxTail + (unsigned int)written) % UART_HOST_TX_SIZE;
+  }
+  event.data.fd = hostFd;
+  event.events = EPOLLIN | (hostTxHead != hostTxTail ? EPOLLOUT : 0);
+  epoll_ctl(hostEpollFd, EPOLL_CTL_MOD, hostFd, &event);
+}
+
+/**
+ * @brief Opens the link the UART is connected to
+ *
+ * @param mode The kind of link
+ *                 UART_HOST_PTY : Creates a pseudo terminal, path receives the name of its slave side
+ *                 UART_HOST_SOCKET_CONNECT : Connects to the UNIX socket at path
+ *                 UART_HOST_SOCKET_LISTEN : Waits for one peer on the UNIX socket at path
+ * @param path The path of the socket or a buffer of at least 64 bytes for the pseudo terminal name
+ * @return int A Status
+ *                  UART_HOST_OK: If the link is open
+ *                  UART_HOST_NOT_OK: If the link could not be opened
+ */
+int UartHost_Open(int mode, char* path)
+{
+  int error = UART_HOST_NOT_OK;
+  int fd;
+  struct epoll_event event;
+  switch (mode)
+  {
+    case UART_HOST_PTY:
+      hostFd = UartHost_OpenPty(path);
+      break;
+    case UART_HOST_SOCKET_CONNECT:
+      hostFd = UartHost_OpenSocket(path, 0);
+      break;
+    case UART_HOST_SOCKET_LISTEN:
+      hostListenFd = UartHost_OpenSocket(path, 1);
+      break;
+  }
+  fd = (hostListenFd >= 0) ? hostListenFd : hostFd;
+  if (fd >= 0 && UartHost_SetNonBlocking(fd) == UART_HOST_OK)
+  {
+    hostEpollFd = epoll_create1(0);
+    event.data.fd = fd;
+    event.events = EPOLLIN;
+    if (hostEpollFd >= 0 && epoll_ctl(hostEpollFd, EPOLL_CTL_ADD, fd, &event) == 0)
+    {
+      hostTxHead = 0;
+      hostTxTail = 0;
+      hostTxComplete = 0;
+      error = UART_HOST_OK;
+    }
+  }
+  if (error != UART_HOST_OK)
+  {
+    UartHost_Close();
+  }
+  return error;
+}
+
+/**
+ * @brief Closes the link
+ *
+ */
+void UartHost_Close(void)
+{
+  if (hostEpollFd >= 0)
+  {
+    close(hostEpollFd);
+  }
+  if (hostPeerFd >= 0)
+  {
+    close(hostPeerFd);
+  }
+  if (hostFd >= 0)
+  {
+    close(hostFd);
+  }
+  if (hostListenFd >= 0)
+  {
+    close(hostListenFd);
+  }
+  hostEpollFd = UART_HOST_NO_FD;
+  hostPeerFd = UART_HOST_NO_FD;
+  hostFd = UART_HOST_NO_FD;
+  hostListenFd = UART_HOST_NO_FD;
+}
+
+/**
+ * @brief Waits for the link and delivers its events to the UART interrupt handlers
+ *        Every received byte is put in UDR before calling the receive handler
+ *        and every transmitted byte calls the transmission complete handler
+ *        once the transmit buffer has room for the next byte, so the driver sends
+ *        as fast as the peer reads and no byte is dropped
+ *
+ * @param timeoutMs The maximum time to wait for an event (-1 to wait forever)
+ * @return int The number of interrupts delivered or UART_HOST_HUNG_UP if the peer hung up
+ */
+int UartHost_Poll(int timeoutMs)
+{
+  struct epoll_event event;
+  unsigned char rx[UART_HOST_RX_CHUNK];
+  ssize_t received;
+  ssize_t itr;
+  int delivered = 0;
+  int hungUp = 0;
+  /* A pending transmission complete is an event on its own so there is nothing to wait for */
+  if (hostTxComplete && UartHost_TxFree())
+  {
+    timeoutMs = 0;
+  }
+  if (epoll_wait(hostEpollFd, &event, 1, timeoutMs) == 1)
+  {
+    if (event.data.fd == hostListenFd)
+    {
+      UartHost_Accept();
+    }
+    else
+    {
+      if (event.events & EPOLLOUT)
+      {
+        UartHost_Flush();
+      }
+      if (event.events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+      {
+        received = read(hostFd, rx, sizeof(rx));
+        for (itr = 0; itr < received; itr++)
+        {
+          Sim_registers[UART_HOST_UDR] = rx[itr];
+          __vector_13();
+          delivered++;
+        }
+        /* The end of the stream or an error other than no data leaves the event set for good */
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EINTR))
+        {
+          UartHost_HangUp();
+          hungUp = 1;
+        }
+      }
+    }
+  }
+  /* Each completion may write the next byte, which queues the next completion */
+  while (hostTxComplete && UartHost_TxFree())
+  {
+    hostTxComplete--;
+    __vector_15();
+    delivered++;
+  }
+  return hungUp ? UART_HOST_HUNG_UP : delivered;
+}
+
+/**
+ * @brief Takes a byte written by the driver to UDR and sends it on the link
+ *
+ * @param byte The written byte
+ */
+void UartHost_Write(unsigned char byte)
+{
+  unsigned int next = (hostTxHead + 1) % UART_HOST_TX_SIZE;
+  Sim_registers[UART_HOST_UDR] = byte;
+  if (next != hostTxTail)
+  {
+    hostTxBuffer[hostTxHead] = byte;
+    hostTxHead = next;
+    UartHost_Flush();
+  }
+  else
+  {
+    hostDropped++;
+  }
+  hostTxComplete++;
+}
+
+/**
+ * @brief Gets the number of bytes dropped because the link could not take them
+ *        or its peer hung up before they were written
+ *
+ * @return unsigned long The number of dropped bytes
+ */
+unsigned long UartHost_GetDroppedBytes(void)
+{
+  return hostDropped;
+}
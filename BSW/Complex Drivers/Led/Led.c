@@ -8,9 +8,236 @@
  */
 #include "Std_Types.h"
 #include "Gpio.h"
+#include "Timer2.h"
+#include "Sched.h"
 #include "Led.h"
 
+/* The levels are kept in 8.8 fixed point so a slow fade still moves every activation */
+#define LED_LEVEL_SHIFT             8
+#define LED_DUTY_FULL               255
+
+/* The Leds turning off at the same count of a period, with their pins on every port of Led_port */
+typedef struct
+{
+    uint8_t duty;
+    uint8_t pins[GPIO_NUMBER_OF_PORTS];
+} ledEdge_t;
+
+/* The pins turned on at the start of a period and the edges turning them off sorted by duty */
+typedef struct
+{
+    uint8_t onPins[GPIO_NUMBER_OF_PORTS];
+    ledEdge_t edges[LED_NUMBER_OF_LEDS];
+    uint8_t numberOfEdges;
+} ledSchedule_t;
+
 extern const led_t Led_leds[LED_NUMBER_OF_LEDS];
+extern const uint8_t Led_gamma[LED_LEVEL_MAX + 1];
+extern const task_t Led_task;
+
+static uint16_t Led_level[LED_NUMBER_OF_LEDS];
+static uint16_t Led_target[LED_NUMBER_OF_LEDS];
+static uint16_t Led_step[LED_NUMBER_OF_LEDS];
+static uint8_t Led_duty[LED_NUMBER_OF_LEDS];
+
+/* The ports of the Leds with the index of the port of every Led */
+static uint8_t Led_port[GPIO_NUMBER_OF_PORTS];
+static uint8_t Led_numberOfPorts;
+static uint8_t Led_portIndex[LED_NUMBER_OF_LEDS];
+static uint8_t Led_pins[GPIO_NUMBER_OF_PORTS];
+static uint8_t Led_onLevels[GPIO_NUMBER_OF_PORTS];
+/* The levels last written to the pins of the Leds on every port */
+static uint8_t Led_output[GPIO_NUMBER_OF_PORTS];
+
+/* The PWM interrupts play Led_schedule[Led_active] while the task builds the other one,
+   Led_swap hands the built one over at the start of the next period */
+static ledSchedule_t Led_schedule[2];
+static volatile uint8_t Led_active;
+static volatile uint8_t Led_swap;
+static uint8_t Led_edge;
+
+/**
+ * @brief Writes the levels of the Led pins of a port
+ *        Only the pins that changed since the last write are written, a port without changes is not accessed
+ *
+ * @param port The index of the port in Led_port
+ * @param levels The levels of the pins, the other pins of the port are not written
+ */
+static void Led_WritePort(uint8_t port, uint8_t levels)
+{
+    uint8_t changed = (levels ^ Led_output[port]) & Led_pins[port];
+    if(changed)
+    {
+        Gpio_WritePortMasked(Led_port[port], changed, levels);
+        Led_output[port] ^= changed;
+    }
+}
+
+/**
+ * @brief Moves the level of a Led by one step of its fade
+ *
+ * @param ledName The name of the LED
+ */
+static void Led_Fade(uint8_t ledName)
+{
+    uint16_t level = Led_level[ledName];
+    uint16_t target = Led_target[ledName];
+    if(level < target)
+    {
+        level = (target - level > Led_step[ledName]) ? level + Led_step[ledName] : target;
+    }
+    else if(level > target)
+    {
+        level = (level - target > Led_step[ledName]) ? level - Led_step[ledName] : target;
+    }
+    Led_level[ledName] = level;
+}
+
+/**
+ * @brief Builds the pins turned on at the start of a period and the edges turning them off
+ *        The Leds with the same duty share an edge so a period has one compare match per duty
+ *
+ * @param schedule The schedule to build, not the one the interrupts play
+ */
+static void Led_Schedule(ledSchedule_t* schedule)
+{
+    uint8_t i;
+    uint8_t p;
+    uint8_t duty = 0;
+    uint8_t next;
+    uint8_t edges = 0;
+    for(p=0; p<Led_numberOfPorts; p++)
+    {
+        schedule->onPins[p] = 0;
+    }
+    for(i=0; i<LED_NUMBER_OF_LEDS; i++)
+    {
+        if(Led_duty[i])
+        {
+            schedule->onPins[Led_portIndex[i]] |= Led_leds[i].pin;
+        }
+    }
+    /* Every pass takes the smallest duty above the last edge, the full duty has no edge */
+    while(edges < LED_NUMBER_OF_LEDS)
+    {
+        next = LED_DUTY_FULL;
+        for(i=0; i<LED_NUMBER_OF_LEDS; i++)
+        {
+            if(Led_duty[i] > duty && Led_duty[i] < next)
+            {
+                next = Led_duty[i];
+            }
+        }
+        if(next == LED_DUTY_FULL)
+        {
+            break;
+        }
+        duty = next;
+        schedule->edges[edges].duty = duty;
+        for(p=0; p<Led_numberOfPorts; p++)
+        {
+            schedule->edges[edges].pins[p] = 0;
+        }
+        for(i=0; i<LED_NUMBER_OF_LEDS; i++)
+        {
+            if(Led_duty[i] == duty)
+            {
+                schedule->edges[edges].pins[Led_portIndex[i]] |= Led_leds[i].pin;
+            }
+        }
+        edges++;
+    }
+    schedule->numberOfEdges = edges;
+}
+
+/**
+ * @brief Turns off the Leds of the edges the timer reached from the compare match of Timer2
+ *        then waits for the next edge, an edge the timer passed meanwhile is written at once
+ *
+ */
+static void Led_PwmCompare(void)
+{
+    const ledSchedule_t* schedule = &Led_schedule[Led_active];
+    const ledEdge_t* edge;
+    uint8_t count;
+    uint8_t p;
+    Timer2_SetCompare((Led_edge < schedule->numberOfEdges) ? schedule->edges[Led_edge].duty : LED_DUTY_FULL);
+    Timer2_GetValue(&count);
+    while(Led_edge < schedule->numberOfEdges && schedule->edges[Led_edge].duty <= count)
+    {
+        edge = &schedule->edges[Led_edge];
+        for(p=0; p<Led_numberOfPorts; p++)
+        {
+            Led_WritePort(p, (Led_output[p] & ~edge->pins[p]) | (~Led_onLevels[p] & edge->pins[p]));
+        }
+        Led_edge++;
+        Timer2_SetCompare((Led_edge < schedule->numberOfEdges) ? schedule->edges[Led_edge].duty : LED_DUTY_FULL);
+        Timer2_GetValue(&count);
+    }
+}
+
+/**
+ * @brief Starts a period of the PWM from the overflow of Timer2
+ *        It takes the schedule the task built if there is one, so a period never mixes two schedules,
+ *        then turns on the Leds with one write per port
+ *
+ */
+static void Led_PwmPeriod(void)
+{
+    uint8_t p;
+    if(Led_swap)
+    {
+        Led_active ^= 1;
+        Led_swap = 0;
+    }
+    for(p=0; p<Led_numberOfPorts; p++)
+    {
+        Led_WritePort(p, ~(Led_onLevels[p] ^ Led_schedule[Led_active].onPins[p]));
+    }
+    Led_edge = 0;
+    Led_PwmCompare();
+}
+
+/**
+ * @brief Moves the fading Leds by one step and builds the schedule of the new duties
+ *        The schedule is built in the task so the interrupts only play it, its cost grows with the square
+ *        of the number of Leds. While the interrupts have not taken the last one the task waits for
+ *        the next activation, then it suspends itself once every Led reached its level
+ *
+ */
+static void Led_Runnable(void)
+{
+    uint8_t i;
+    uint8_t duty;
+    uint8_t changed = 0;
+    uint8_t fading = 0;
+    if(!Led_swap)
+    {
+        for(i=0; i<LED_NUMBER_OF_LEDS; i++)
+        {
+            Led_Fade(i);
+            if(Led_level[i] != Led_target[i])
+            {
+                fading = 1;
+            }
+            duty = Led_gamma[Led_level[i] >> LED_LEVEL_SHIFT];
+            if(duty != Led_duty[i])
+            {
+                Led_duty[i] = duty;
+                changed = 1;
+            }
+        }
+        if(changed)
+        {
+            Led_Schedule(&Led_schedule[Led_active ^ 1]);
+            Led_swap = 1;
+        }
+        if(!fading)
+        {
+            Sched_SuspendTask();
+        }
+    }
+}
 
 /**
  * Function:  Led_Init 
@@ -25,6 +252,7 @@ extern const led_t Led_leds[LED_NUMBER_OF_LEDS];
 Std_ReturnType Led_Init(void)
 {
     uint8_t i;
+    uint8_t p;
     gpio_t gpio;
 	gpio.mode = GPIO_MODE_OUTPUT_PP;
     for(i=0; i<LED_NUMBER_OF_LEDS; i++)
@@ -32,7 +260,29 @@ Std_ReturnType Led_Init(void)
         gpio.pins = Led_leds[i].pin;
         gpio.port = Led_leds[i].port;
         Gpio_InitPins(&gpio);
+        for(p=0; p<Led_numberOfPorts && Led_port[p] != Led_leds[i].port; p++);
+        if(p == Led_numberOfPorts)
+        {
+            Led_port[p] = Led_leds[i].port;
+            Led_numberOfPorts++;
+        }
+        Led_portIndex[i] = p;
+        Led_pins[p] |= Led_leds[i].pin;
+        if(Led_leds[i].activeState == GPIO_PIN_SET)
+        {
+            Led_onLevels[p] |= Led_leds[i].pin;
+        }
+    }
+    for(p=0; p<Led_numberOfPorts; p++)
+    {
+        Gpio_WritePortMasked(Led_port[p], Led_pins[p], ~Led_onLevels[p]);
+        Led_output[p] = ~Led_onLevels[p];
     }
+    Timer2_SetOverflowCallBack(Led_PwmPeriod);
+    Timer2_SetCompareCallBack(Led_PwmCompare);
+    Timer2_Start(LED_PWM_PRESCALER);
+    Timer2_OverflowInterruptEnable();
+    Timer2_CompareInterruptEnable();
     return E_OK;
 }
 
@@ -49,8 +299,7 @@ Std_ReturnType Led_Init(void)
  */
 extern Std_ReturnType Led_SetLedOn(uint8_t ledName)
 {
-    Gpio_WritePin(Led_leds[ledName].port, Led_leds[ledName].pin, Led_leds[ledName].activeState);
-    return E_OK;
+    return Led_SetLedStatus(ledName, LED_ON);
 }
 
 /**
@@ -66,8 +315,7 @@ extern Std_ReturnType Led_SetLedOn(uint8_t ledName)
  */
 Std_ReturnType Led_SetLedOff(uint8_t ledName)
 {
-    Gpio_WritePin(Led_leds[ledName].port, Led_leds[ledName].pin, !Led_leds[ledName].activeState);
-    return E_OK;
+    return Led_SetLedStatus(ledName, LED_OFF);
 }
 
 /**
@@ -87,6 +335,85 @@ Std_ReturnType Led_SetLedOff(uint8_t ledName)
  */
 Std_ReturnType Led_SetLedStatus(uint8_t ledName, uint8_t status)
 {
-    Gpio_WritePin(Led_leds[ledName].port, Led_leds[ledName].pin, status^Led_leds[ledName].activeState);
-    return E_OK;
-}
\ No newline at end of file
+    Std_ReturnType error = E_NOT_OK;
+    if(status == LED_ON)
+    {
+        error = Led_SetLedLevel(ledName, LED_LEVEL_MAX, 0);
+    }
+    else if(status == LED_OFF)
+    {
+        error = Led_SetLedLevel(ledName, 0, 0);
+    }
+    return error;
+}
+
+/**
+ * Function:  Led_SetLedLevel 
+ * --------------------
+ *  @brief Fades the Led to a brightness level
+ *         The Led task moves the level by the same step every activation so the fade takes fadeMs
+ *         whatever level it starts from, the level goes through the gamma table of Led_Cfg.c
+ * 
+ *  @param ledName: The name of the LED
+ *                  
+ *  @param level: The brightness level from 0 to LED_LEVEL_MAX
+ *  
+ *  @param fadeMs: The time of the fade, 0 sets the level at once
+ *  
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Led_SetLedLevel(uint8_t ledName, uint8_t level, uint16_t fadeMs)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint16_t target = (uint16_t)level << LED_LEVEL_SHIFT;
+    uint16_t distance;
+    uint16_t periods = fadeMs / LED_TASK_PERIOD_MS;
+    if(ledName < LED_NUMBER_OF_LEDS && level <= LED_LEVEL_MAX)
+    {
+        distance = (target > Led_level[ledName]) ? target - Led_level[ledName] : Led_level[ledName] - target;
+        /* Asking again for the level a Led has or fades to changes nothing so no period is updated */
+        if(periods == 0 && Led_level[ledName] != target)
+        {
+            /* The next activation of the task builds the schedule of the target */
+            Led_level[ledName] = target;
+            Led_step[ledName] = 0;
+            Sched_ActivateTask(&Led_task);
+        }
+        else if(periods != 0 && target != Led_target[ledName])
+        {
+            Led_step[ledName] = (distance / periods) ? distance / periods : 1;
+            Sched_ActivateTask(&Led_task);
+        }
+        Led_target[ledName] = target;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * Function:  Led_GetLedLevel 
+ * --------------------
+ *  @brief Gets the brightness level a Led has now, in the middle of a fade too
+ * 
+ *  @param ledName: The name of the LED
+ *                  
+ *  @param level: Save the brightness level from 0 to LED_LEVEL_MAX in
+ *  
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Led_GetLedLevel(uint8_t ledName, uint8_t* level)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(ledName < LED_NUMBER_OF_LEDS)
+    {
+        *level = Led_level[ledName] >> LED_LEVEL_SHIFT;
+        error = E_OK;
+    }
+    return error;
+}
+
+const task_t Led_task = {Led_Runnable, LED_TASK_PERIOD_MS};
@@ -21,6 +21,9 @@ typedef struct
 #define LED_ON              0
 #define LED_OFF             1
 
+/* The brightness of a Led in percent */
+#define LED_LEVEL_MAX       100
+
 
 /**
  * Function:  Led_Init 
@@ -77,5 +80,40 @@ extern Std_ReturnType Led_SetLedOff(uint8_t ledName);
  */
 extern Std_ReturnType Led_SetLedStatus(uint8_t ledName, uint8_t status);
 
+/**
+ * Function:  Led_SetLedLevel 
+ * --------------------
+ *  @brief Fades the Led to a brightness level
+ *         The Led task moves the level by the same step every LED_TASK_PERIOD_MS so the fade takes fadeMs
+ *         whatever level it starts from, the level goes through the gamma table of Led_Cfg.c
+ *         and the Timer2 interrupt only replays the PWM schedule the task built
+ * 
+ *  @param ledName: The name of the LED
+ *                  
+ *  @param level: The brightness level from 0 to LED_LEVEL_MAX
+ *  
+ *  @param fadeMs: The time of the fade, 0 sets the level at once
+ *  
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Led_SetLedLevel(uint8_t ledName, uint8_t level, uint16_t fadeMs);
+
+/**
+ * Function:  Led_GetLedLevel 
+ * --------------------
+ *  @brief Gets the brightness level a Led has now, in the middle of a fade too
+ * 
+ *  @param ledName: The name of the LED
+ *                  
+ *  @param level: Save the brightness level from 0 to LED_LEVEL_MAX in
+ *  
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Led_GetLedLevel(uint8_t ledName, uint8_t* level);
+
 
 #endif
\ No newline at end of file
@@ -5,3 +5,18 @@
 const led_t Led_leds[LED_NUMBER_OF_LEDS] = {
     {GPIO_PIN_0, GPIO_PORTA, GPIO_PIN_SET}
 };
+
+/* The PWM duty of every brightness level, 255 * (level / 100) ^ 2.2 with at least 1 above level 0 */
+const uint8_t Led_gamma[LED_LEVEL_MAX + 1] = {
+      0,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      2,   2,   2,   3,   3,   4,   5,   5,   6,   7,
+      7,   8,   9,  10,  11,  12,  13,  14,  15,  17,
+     18,  19,  21,  22,  24,  25,  27,  29,  30,  32,
+     34,  36,  38,  40,  42,  44,  46,  48,  51,  53,
+     55,  58,  60,  63,  66,  68,  71,  74,  77,  80,
+     83,  86,  89,  92,  96,  99, 102, 106, 109, 113,
+    116, 120, 124, 128, 131, 135, 139, 143, 148, 152,
+    156, 160, 165, 169, 174, 178, 183, 188, 192, 197,
+    202, 207, 212, 217, 223, 228, 233, 238, 244, 249,
+    255
+};
@@ -13,5 +13,12 @@
 
 #define DIMMER_LAMP                     0
 
+/* The period of the PWM, 256 counts of Timer2 clocked at 8MHz / 256 which is about 122Hz */
+#define LED_PWM_PRESCALER               TMR2_DIV_256
+#define LED_PWM_PERIOD_US               8192
+
+/* The period of the Led task moving the fades and building the PWM schedule, a multiple of the scheduler tick */
+#define LED_TASK_PERIOD_MS              10
+
 
 #endif
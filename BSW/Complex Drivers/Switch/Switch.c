@@ -10,9 +10,120 @@
 #include "Gpio.h"
 #include "Switch.h"
 #include "Sched.h"
+#include "Timer0.h"
+#include "Trace.h"
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+#include "Exti.h"
+#endif
+
+/* Debounces the pins of a port together, bit n of every field is the lane of GPIO_PIN_n
+   The counter of a lane is spread over count0 to count3 so a tick updates all of them at once,
+   it starts from the preload of the lane and the new level is taken when it is 0 */
+typedef struct
+{
+    uint8_t port;
+    uint8_t pins;
+    uint8_t debounced;
+    uint8_t count0;
+    uint8_t count1;
+    uint8_t count2;
+    uint8_t count3;
+    uint8_t preload0;
+    uint8_t preload1;
+    uint8_t preload2;
+    uint8_t preload3;
+} switchPort_t;
+
+typedef struct
+{
+    switchEvent_t event[SWITCH_EVENT_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t count;
+} switchQueue_t;
+
+typedef struct
+{
+    uint32_t pressUs;       /* The first press of a double click */
+    uint32_t deadlineUs;    /* The end of a long press */
+} switchGesture_t;
+
+#define SWITCH_BIT(switchName)          ((uint32_t)1 << (switchName))
+#define SWITCH_US(ms)                   ((uint32_t)(ms) * 1000)
+
+#if SWITCH_NUMBER_OF_SWITCHES > 32
+#error "The gestures support up to 32 switches"
+#endif
 
 extern const switch_t Switch_switches[SWITCH_NUMBER_OF_SWITCHES];
+extern const callback_t Switch_edgeCallBack;
 static uint8_t Switch_state[SWITCH_NUMBER_OF_SWITCHES];
+static uint8_t Switch_sequence;
+/* The ports of the switches, each one is read and debounced once per run */
+static switchPort_t Switch_ports[GPIO_NUMBER_OF_PORTS];
+static uint8_t Switch_portIndex[SWITCH_NUMBER_OF_SWITCHES];
+static uint8_t Switch_numberOfPorts;
+static switchQueue_t Switch_events[SWITCH_NUMBER_OF_SWITCHES];
+static switchGesture_t Switch_gesture[SWITCH_NUMBER_OF_SWITCHES];
+/* The switches waiting for the end of a long press and the ones pressed once for a double click */
+static uint32_t Switch_timing;
+static uint32_t Switch_clicked;
+
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+extern const task_t Switch_task;
+
+/* The external interrupt line of every switch */
+static uint8_t Switch_line[SWITCH_NUMBER_OF_SWITCHES];
+
+/**
+ * @brief Called from the interrupt of an edge on a switch
+ *        The lines stay disabled while the task debounces so a bouncing contact
+ *        costs one interrupt only
+ *
+ */
+static void Switch_Wake(void)
+{
+    uint8_t i;
+    for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
+    {
+        Exti_Disable(Switch_line[i]);
+    }
+    Sched_ActivateTask(&Switch_task);
+}
+
+/**
+ * @brief Suspends the switch task until the next edge once all of the switches settled
+ *        Setting the sense clears the flags the bouncing left while the lines were disabled
+ *        INT2 only senses one edge so it is set to the edge leaving the debounced level
+ *
+ */
+static void Switch_Sleep(void)
+{
+    uint8_t i;
+    uint8_t levels;
+    uint8_t sense;
+    Sched_SuspendTask();
+    for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
+    {
+        sense = EXTI_SENSE_ANY_CHANGE;
+        if(Switch_line[i] == EXTI_INT2)
+        {
+            sense = (Switch_ports[Switch_portIndex[i]].debounced & Switch_switches[i].pin) ?
+                    EXTI_SENSE_FALLING : EXTI_SENSE_RISING;
+        }
+        Exti_SetSense(Switch_line[i], sense);
+        Exti_Enable(Switch_line[i]);
+    }
+    /* A switch that changed since the last sample had its flag cleared, it is caught here */
+    for(i=0; i<Switch_numberOfPorts; i++)
+    {
+        Gpio_ReadPort(Switch_ports[i].port, &levels);
+        if((levels ^ Switch_ports[i].debounced) & Switch_ports[i].pins)
+        {
+            Sched_ActivateTask(&Switch_task);
+        }
+    }
+}
+#endif
 
 /**
  * Function:  Switch_Init 
@@ -26,9 +137,43 @@ static uint8_t Switch_state[SWITCH_NUMBER_OF_SWITCHES];
 Std_ReturnType Switch_Init(void)
 {
     uint8_t i;
+    uint8_t port;
+    uint8_t preload;
     gpio_t gpio;
+    Switch_numberOfPorts = 0;
+    Switch_timing = 0;
+    Switch_clicked = 0;
     for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
     {
+        for(port=0; port<Switch_numberOfPorts && Switch_ports[port].port != Switch_switches[i].port; port++);
+        if(port == Switch_numberOfPorts)
+        {
+            Switch_ports[port].port = Switch_switches[i].port;
+            Switch_ports[port].pins = 0;
+            Switch_ports[port].debounced = 0;
+            Switch_ports[port].preload0 = 0;
+            Switch_ports[port].preload1 = 0;
+            Switch_ports[port].preload2 = 0;
+            Switch_ports[port].preload3 = 0;
+            Switch_numberOfPorts++;
+        }
+        Switch_portIndex[i] = port;
+        Switch_ports[port].pins |= Switch_switches[i].pin;
+        /* The preload of the lane is spread over the planes like its counter */
+        preload = Switch_switches[i].debounceSamples - 1;
+        Switch_ports[port].preload0 |= (preload & 0x01) ? Switch_switches[i].pin : 0;
+        Switch_ports[port].preload1 |= (preload & 0x02) ? Switch_switches[i].pin : 0;
+        Switch_ports[port].preload2 |= (preload & 0x04) ? Switch_switches[i].pin : 0;
+        Switch_ports[port].preload3 |= (preload & 0x08) ? Switch_switches[i].pin : 0;
+        Switch_ports[port].count0 = Switch_ports[port].preload0;
+        Switch_ports[port].count1 = Switch_ports[port].preload1;
+        Switch_ports[port].count2 = Switch_ports[port].preload2;
+        Switch_ports[port].count3 = Switch_ports[port].preload3;
+        /* A switch starts released, which is high for a switch pulling its pin low */
+        if(Switch_switches[i].activeState == GPIO_PIN_RESET)
+        {
+            Switch_ports[port].debounced |= Switch_switches[i].pin;
+        }
         switch(Switch_switches[i].activeState)
         {
             case GPIO_PIN_RESET:
@@ -42,6 +187,14 @@ Std_ReturnType Switch_Init(void)
         gpio.port = Switch_switches[i].port;
         Gpio_InitPins(&gpio);
         Switch_state[i] = SWITCH_NOT_PRESSED;
+        Switch_events[i].count = 0;
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+        if(Exti_GetLine(Switch_switches[i].port, Switch_switches[i].pin, &Switch_line[i]) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+        Exti_SetCallBack(Switch_line[i], Switch_Wake);
+#endif
     }
     return E_OK;
 }
@@ -50,7 +203,7 @@ Std_ReturnType Switch_Init(void)
 /**
  * Function:  Switch_GetSwitchStatus 
  * --------------------
- *  @brief Gets the status of the switch
+ *  @brief Gets the debounced status of the switch
  * 
  *  @param switchName: The name of the Switch
  *                   
@@ -63,48 +216,228 @@ Std_ReturnType Switch_Init(void)
  */
 Std_ReturnType Switch_GetSwitchStatus(uint8_t switchName, uint8_t* state)
 {
-    #ifndef SWITCH_USE_RTOS
-        uint8_t readVal;
-        Gpio_ReadPin(Switch_switches[switchName].port, Switch_switches[switchName].pin, &readVal);
-        *state = (Switch_switches[switchName].activeState ^ readVal);
-        return E_OK;
-    #else
+    Std_ReturnType error = E_NOT_OK;
+    if(switchName < SWITCH_NUMBER_OF_SWITCHES)
+    {
         *state = Switch_state[switchName];
-        return E_OK;
-    #endif
+        error = E_OK;
+    }
+    return error;
 }
 
 /**
- * @brief The running task of the switch driver to get the state of all of the switches
+ * Function:  Switch_GetSequence 
+ * --------------------
+ *  @brief Gets the sequence tag of the last switch change
+ *         It counts the debounced changes of all the switches so an output can be traced back to its input
  * 
+ *  @param sequence: Save the sequence tag in
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
  */
-static void Switch_Runnable(void)
+Std_ReturnType Switch_GetSequence(uint8_t* sequence)
 {
-    uint8_t i,readVal;
-    static uint8_t prevState[SWITCH_NUMBER_OF_SWITCHES];
-    static uint8_t counter[SWITCH_NUMBER_OF_SWITCHES];
-    uint8_t currentState;
-    for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
+    *sequence = Switch_sequence;
+    return E_OK;
+}
+
+/**
+ * Function:  Switch_GetEvent 
+ * --------------------
+ *  @brief Takes the oldest edge of a switch
+ *         The switch task queues an edge every time the debounced status changes,
+ *         the oldest edge is dropped when a switch changes faster than its edges are taken
+ * 
+ *  @param switchName: The name of the Switch
+ *                   
+ *  @param event: Save the edge in
+ *  @returns: A status
+ *                 E_OK : if an edge is returned
+ *                 E_NOT_OK : if the switch has no edge or does not exist
+ */
+Std_ReturnType Switch_GetEvent(uint8_t switchName, switchEvent_t* event)
+{
+    Std_ReturnType error = E_NOT_OK;
+    switchQueue_t* queue;
+    if(switchName < SWITCH_NUMBER_OF_SWITCHES && Switch_events[switchName].count)
+    {
+        queue = &Switch_events[switchName];
+        *event = queue->event[queue->head];
+        queue->head = (queue->head + 1) % SWITCH_EVENT_QUEUE_SIZE;
+        queue->count--;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Queues an edge of a switch, the oldest one makes room when the queue is full
+ *
+ * @param switchName The name of the Switch
+ * @param edge SWITCH_EDGE_PRESSED or SWITCH_EDGE_RELEASED
+ * @param timeUs The time of the edge
+ */
+static void Switch_PushEvent(uint8_t switchName, uint8_t edge, uint32_t timeUs)
+{
+    switchQueue_t* queue = &Switch_events[switchName];
+    if(queue->count == SWITCH_EVENT_QUEUE_SIZE)
+    {
+        queue->head = (queue->head + 1) % SWITCH_EVENT_QUEUE_SIZE;
+        queue->count--;
+    }
+    queue->event[(queue->head + queue->count) % SWITCH_EVENT_QUEUE_SIZE].edge = edge;
+    queue->event[(queue->head + queue->count) % SWITCH_EVENT_QUEUE_SIZE].timeUs = timeUs;
+    queue->count++;
+}
+
+/**
+ * @brief Debounces all the pins of a port with a new sample
+ *        A lane differing from its debounced level counts down and takes the new level
+ *        after the debounce samples of its switch in a row, any other lane gets its counter preloaded
+ *
+ * @param port The port to debounce
+ * @param levels The levels read from the port
+ * @return uint8_t The pins that changed their debounced level
+ */
+static uint8_t Switch_Debounce(switchPort_t* port, uint8_t levels)
+{
+    uint8_t delta = (levels ^ port->debounced) & port->pins;
+    uint8_t expired = delta & ~(port->count0 | port->count1 | port->count2 | port->count3);
+    uint8_t counting = delta & ~expired;
+    /* Subtracts one from the counting lanes, the borrow ripples through the planes */
+    uint8_t borrow1 = counting & ~port->count0;
+    uint8_t borrow2 = borrow1 & ~port->count1;
+    uint8_t borrow3 = borrow2 & ~port->count2;
+    port->count0 = ((port->count0 ^ counting) & counting) | (port->preload0 & ~counting);
+    port->count1 = ((port->count1 ^ borrow1) & counting) | (port->preload1 & ~counting);
+    port->count2 = ((port->count2 ^ borrow2) & counting) | (port->preload2 & ~counting);
+    port->count3 = ((port->count3 ^ borrow3) & counting) | (port->preload3 & ~counting);
+    port->debounced ^= expired;
+    return expired;
+}
+
+/**
+ * @brief Recognizes the gestures of a switch on one of its edges
+ *        A press starts the long press time and ends a double click when it is close enough
+ *        to the previous press, a release stops the long press time
+ *
+ * @param switchName The name of the Switch
+ * @param timeUs The time of the edge
+ */
+static void Switch_Gesture(uint8_t switchName, uint32_t timeUs)
+{
+    uint8_t gestures = Switch_switches[switchName].gestures;
+    if(Switch_state[switchName] == SWITCH_PRESSED)
     {
-        Gpio_ReadPin(Switch_switches[i].port, Switch_switches[i].pin, &readVal);
-        currentState = (Switch_switches[i].activeState ^ readVal);
-        if(currentState == prevState[i])
+        if(gestures & SWITCH_GESTURE_DOUBLE_CLICK)
         {
-            counter[i]++;
+            if((Switch_clicked & SWITCH_BIT(switchName)) &&
+               timeUs - Switch_gesture[switchName].pressUs <= SWITCH_US(SWITCH_DOUBLE_CLICK_MS))
+            {
+                Switch_PushEvent(switchName, SWITCH_EDGE_DOUBLE_CLICK, timeUs);
+                Switch_clicked &= ~SWITCH_BIT(switchName);
+            }
+            else
+            {
+                Switch_gesture[switchName].pressUs = timeUs;
+                Switch_clicked |= SWITCH_BIT(switchName);
+            }
         }
-        else
+        if(gestures & SWITCH_GESTURE_LONG_PRESS)
         {
-            counter[i] = 0;
+            Switch_gesture[switchName].deadlineUs = timeUs + SWITCH_US(SWITCH_LONG_PRESS_MS);
+            Switch_timing |= SWITCH_BIT(switchName);
         }
+    }
+    else
+    {
+        Switch_timing &= ~SWITCH_BIT(switchName);
+    }
+}
 
-        if(counter[i] == 5)
+/**
+ * @brief Queues a long press for the switches held until the end of their long press time
+ *
+ * @param timeUs The current time
+ */
+static void Switch_LongPress(uint32_t timeUs)
+{
+    uint8_t i;
+    for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
+    {
+        if((Switch_timing & SWITCH_BIT(i)) && (sint32_t)(timeUs - Switch_gesture[i].deadlineUs) >= 0)
         {
-            Switch_state[i] = currentState;
-            counter[i] = 0;
+            Switch_PushEvent(i, SWITCH_EDGE_LONG_PRESS, Switch_gesture[i].deadlineUs);
+            Switch_timing &= ~SWITCH_BIT(i);
         }
-        prevState[i] = currentState;
     }
+}
 
+/**
+ * @brief The running task of the switch driver to get the state of all of the switches
+ *        Each port is read and debounced at once, only the switches that changed are visited
+ *        and the ones timing a long press
+ * 
+ */
+static void Switch_Runnable(void)
+{
+    uint8_t i,readVal;
+    uint8_t levels;
+    uint8_t changed = 0;
+    uint8_t pending = 0;
+    uint32_t timeUs = 0;
+    uint32_t edgeUs;
+    for(i=0; i<Switch_numberOfPorts; i++)
+    {
+        Gpio_ReadPort(Switch_ports[i].port, &levels);
+        if(Switch_Debounce(&Switch_ports[i], levels))
+        {
+            changed = 1;
+        }
+        pending |= (levels ^ Switch_ports[i].debounced) & Switch_ports[i].pins;
+    }
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+    /* A long press is timed by the task so it keeps running until it ends */
+    if(!pending && !Switch_timing)
+    {
+        Switch_Sleep();
+    }
+#else
+    (void)pending;
+#endif
+    if(changed || Switch_timing)
+    {
+        Timer0_GetTimestampUs(&timeUs);
+    }
+    if(changed)
+    {
+        for(i=0; i<SWITCH_NUMBER_OF_SWITCHES; i++)
+        {
+            readVal = !(Switch_ports[Switch_portIndex[i]].debounced & Switch_switches[i].pin);
+            if(Switch_state[i] != (Switch_switches[i].activeState ^ readVal))
+            {
+                /* The change is taken at the last of its samples, the edge came with the first one */
+                edgeUs = timeUs - SWITCH_US((Switch_switches[i].debounceSamples - 1) * SWITCH_PERIOD_MS);
+                Switch_state[i] = Switch_switches[i].activeState ^ readVal;
+                Switch_PushEvent(i, Switch_state[i], edgeUs);
+                if(Switch_switches[i].gestures != SWITCH_GESTURE_NONE)
+                {
+                    Switch_Gesture(i, edgeUs);
+                }
+                Switch_sequence++;
+                TRACE(TRACE_EVENT_SEQUENCE_START, i, Switch_sequence);
+                if(Switch_edgeCallBack)
+                {
+                    Switch_edgeCallBack();
+                }
+            }
+        }
+    }
+    if(Switch_timing)
+    {
+        Switch_LongPress(timeUs);
+    }
 }
 
-const task_t Switch_task = {Switch_Runnable, 5}; 
\ No newline at end of file
+const task_t Switch_task = {Switch_Runnable, SWITCH_PERIOD_MS}; 
\ No newline at end of file
@@ -15,11 +15,43 @@ typedef struct
     uint32_t pin;
     uint32_t port;
     uint8_t activeState;
+    uint8_t debounceSamples;    /* SWITCH_DEBOUNCE_MS of the debounce time */
+    uint8_t gestures;           /* The SWITCH_GESTURE_X recognized on the switch, ORed */
 } switch_t;
 
+#define SWITCH_PERIOD_MS                5
+
+#define SWITCH_MAX_DEBOUNCE_SAMPLES     16
+
+/* The number of samples of the switch task in a debounce time */
+#define SWITCH_DEBOUNCE_SAMPLES(ms)     ((ms) <= SWITCH_PERIOD_MS ? 1 : ((ms) + SWITCH_PERIOD_MS - 1) / SWITCH_PERIOD_MS)
+
+/* Converts a debounce time to the number of samples of the switch task, from 1 to 16
+   A longer time fails the build of Switch_Cfg.c with a negative array size */
+#define SWITCH_DEBOUNCE_MS(ms)          (SWITCH_DEBOUNCE_SAMPLES(ms) + 0 * \
+                                         sizeof(char[SWITCH_DEBOUNCE_SAMPLES(ms) <= SWITCH_MAX_DEBOUNCE_SAMPLES ? 1 : -1]))
+
+#define SWITCH_GESTURE_NONE             0x00
+#define SWITCH_GESTURE_LONG_PRESS       0x01
+#define SWITCH_GESTURE_DOUBLE_CLICK     0x02
+
 #define SWITCH_NOT_PRESSED              1
 #define SWITCH_PRESSED                  0
 
+#define SWITCH_EDGE_PRESSED             SWITCH_PRESSED
+#define SWITCH_EDGE_RELEASED            SWITCH_NOT_PRESSED
+#define SWITCH_EDGE_LONG_PRESS          2
+#define SWITCH_EDGE_DOUBLE_CLICK        3
+
+typedef struct
+{
+    uint8_t edge;       /* SWITCH_EDGE_X */
+    uint32_t timeUs;    /* The Timer0_GetTimestampUs of the first sample at the new state, or of the end of a long press */
+} switchEvent_t;
+
+#define SWITCH_DETECTION_POLLING        0
+#define SWITCH_DETECTION_INTERRUPT      1
+
 /**
  * Function:  Switch_Init 
  * --------------------
@@ -34,7 +66,7 @@ extern Std_ReturnType Switch_Init(void);
 /**
  * Function:  Switch_GetSwitchStatus 
  * --------------------
- *  @brief Gets the status of the switch
+ *  @brief Gets the debounced status of the switch
  * 
  *  @param switchName: The name of the Switch
  *                   
@@ -47,4 +79,35 @@ extern Std_ReturnType Switch_Init(void);
  */
 extern Std_ReturnType Switch_GetSwitchStatus(uint8_t switchName, uint8_t* state);
 
+/**
+ * Function:  Switch_GetSequence 
+ * --------------------
+ *  @brief Gets the sequence tag of the last switch change
+ *         It counts the debounced changes of all the switches so an output can be traced back to its input
+ * 
+ *  @param sequence: Save the sequence tag in
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Switch_GetSequence(uint8_t* sequence);
+
+/**
+ * Function:  Switch_GetEvent 
+ * --------------------
+ *  @brief Takes the oldest edge of a switch
+ *         The switch task queues an edge every time the debounced status changes
+ *         and when it recognizes a gesture the switch is configured for,
+ *         the oldest edge is dropped when a switch changes faster than its edges are taken
+ *         The RTE door servers take the edges of the doors
+ * 
+ *  @param switchName: The name of the Switch
+ *                   
+ *  @param event: Save the edge in
+ *  @returns: A status
+ *                 E_OK : if an edge is returned
+ *                 E_NOT_OK : if the switch has no edge or does not exist
+ */
+extern Std_ReturnType Switch_GetEvent(uint8_t switchName, switchEvent_t* event);
+
 #endif
@@ -10,7 +10,24 @@
 #include "Gpio.h"
 #include "Switch.h"
 
+extern void Rte_SwitchEdge(void);
+
+/* The doors are moved to INT0 and INT1 when the switches are watched with interrupts */
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+#define LEFT_DOOR_PIN                   GPIO_PIN_2
+#define RIGHT_DOOR_PIN                  GPIO_PIN_3
+#define DOOR_PORT                       GPIO_PORTD
+#else
+#define LEFT_DOOR_PIN                   GPIO_PIN_1
+#define RIGHT_DOOR_PIN                  GPIO_PIN_2
+#define DOOR_PORT                       GPIO_PORTA
+#endif
+
 const switch_t Switch_switches[SWITCH_NUMBER_OF_SWITCHES] = {
-    {GPIO_PIN_1, GPIO_PORTA, GPIO_PIN_RESET},
-    {GPIO_PIN_2, GPIO_PORTA, GPIO_PIN_RESET}
+    /*Pin            Port       Active State    Debounce                Gestures*/
+    {LEFT_DOOR_PIN,  DOOR_PORT, GPIO_PIN_RESET, SWITCH_DEBOUNCE_MS(30), SWITCH_GESTURE_NONE},
+    {RIGHT_DOOR_PIN, DOOR_PORT, GPIO_PIN_RESET, SWITCH_DEBOUNCE_MS(30), SWITCH_GESTURE_NONE}
 };
+
+/* Called after every edge is queued, the RTE wakes the vehicle up on a door edge */
+const callback_t Switch_edgeCallBack = Rte_SwitchEdge;
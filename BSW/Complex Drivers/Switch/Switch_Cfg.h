@@ -9,10 +9,25 @@
 #ifndef SWITCH_CFG_H
 #define SWITCH_CFG_H
 
-#define SWITCH_USE_RTOS
-
 #define SWITCH_NUMBER_OF_SWITCHES             2
 
+/* The number of edges kept for every switch until they are taken with Switch_GetEvent */
+#define SWITCH_EVENT_QUEUE_SIZE               4
+
+/* The time a switch with SWITCH_GESTURE_LONG_PRESS is held for a long press */
+#define SWITCH_LONG_PRESS_MS                  1000
+/* The longest time between two presses of a switch with SWITCH_GESTURE_DOUBLE_CLICK for a double click */
+#define SWITCH_DOUBLE_CLICK_MS                400
+
+/* How the switches are watched
+   SWITCH_DETECTION_POLLING : They are sampled every 5 ms
+   SWITCH_DETECTION_INTERRUPT : The switch task sleeps until an edge on INT0, INT1 or INT2 and samples
+                                the switches until they settle, every switch must be on PD2, PD3 or PB2
+   It can also be given on the command line with -DSWITCH_DETECTION=SWITCH_DETECTION_INTERRUPT */
+#ifndef SWITCH_DETECTION
+#define SWITCH_DETECTION                      SWITCH_DETECTION_POLLING
+#endif
+
 #define LEFT_DOOR                             0
 #define RIGHT_DOOR                            1
 
@@ -0,0 +1,254 @@
+/**
+ * @file  Exti.c
+ * @brief This file is to be used as an implementation of the external interrupts driver.
+ *
+ * @author Mark Attia
+ * @date April 30, 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Reg_Access.h"
+#include "Gpio.h"
+#include "Exti.h"
+
+#define MCUCSR                      REG8(0x54)
+#define MCUCR                       REG8(0x55)
+#define GIFR                        REG8(0x5A)
+#define GICR                        REG8(0x5B)
+#define SREG                        REG8(0x5F)
+
+#define GLOBAL_INT_DIS              0x7F
+
+#define EXTI_INT2_RISING            0x40
+#define EXTI_INT0_SENSE_SHIFT       0
+#define EXTI_INT1_SENSE_SHIFT       2
+#define EXTI_SENSE_MASK             0x03
+
+/* A flag is cleared by writing one to it, the register file of HOST_SIM only keeps what is written */
+#ifdef HOST_SIM
+#define EXTI_CLEAR_FLAG(bit)        (GIFR &= ~(bit))
+#else
+#define EXTI_CLEAR_FLAG(bit)        (GIFR = (bit))
+#endif
+
+#ifdef GPIO_HOST_BACKEND
+#include "GpioHost.h"
+#define EXTI_SYNC(line)             GpioHost_Sync(Exti_port[line])
+#else
+#define EXTI_SYNC(line)
+#endif
+
+void __vector_1 (void) __attribute__ ((signal, used, externally_visible));
+void __vector_2 (void) __attribute__ ((signal, used, externally_visible));
+void __vector_3 (void) __attribute__ ((signal, used, externally_visible));
+
+/* The enable bit in GICR and the flag in GIFR of every line */
+static const uint8_t Exti_bit[EXTI_NUMBER_OF_LINES] = {0x40, 0x80, 0x20};
+static const uint8_t Exti_port[EXTI_NUMBER_OF_LINES] = {GPIO_PORTD, GPIO_PORTD, GPIO_PORTB};
+static const uint8_t Exti_pin[EXTI_NUMBER_OF_LINES] = {GPIO_PIN_2, GPIO_PIN_3, GPIO_PIN_2};
+
+static callback_t Exti_func[EXTI_NUMBER_OF_LINES];
+
+/**
+ * Function:  Exti_GetLine
+ * --------------------
+ *  @brief Gets the external interrupt line of a pin
+ *         INT0 is on PD2, INT1 on PD3 and INT2 on PB2
+ *
+ *  @param port: The port of the pin
+ *                 @arg GPIO_PORTX : The port of the pin
+ *
+ *  @param pin: The pin
+ *                 @arg GPIO_PIN_X : The pin
+ *
+ *  @param line: To return the line in
+ *                 @arg EXTI_INTX : The line of the pin
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the pin has no external interrupt
+ */
+Std_ReturnType Exti_GetLine(uint8_t port, uint8_t pin, uint8_t* line)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t i;
+    for(i=0; i<EXTI_NUMBER_OF_LINES; i++)
+    {
+        if(Exti_port[i] == port && Exti_pin[i] == pin)
+        {
+            *line = i;
+            error = E_OK;
+        }
+    }
+    return error;
+}
+
+/**
+ * Function:  Exti_SetSense
+ * --------------------
+ *  @brief Sets the pin event that triggers a line
+ *         The flag of the line is cleared as changing the sense may raise it
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  @param sense: The event triggering the line
+ *                 @arg EXTI_SENSE_LOW_LEVEL : While the pin is low (INT0 and INT1)
+ *                 @arg EXTI_SENSE_ANY_CHANGE : On any edge (INT0 and INT1)
+ *                 @arg EXTI_SENSE_FALLING : On a falling edge
+ *                 @arg EXTI_SENSE_RISING : On a rising edge
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Exti_SetSense(uint8_t line, uint8_t sense)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t sreg = SREG;
+    SREG = sreg & GLOBAL_INT_DIS;
+    switch(line)
+    {
+        case EXTI_INT0:
+            MCUCR = (MCUCR & ~(EXTI_SENSE_MASK << EXTI_INT0_SENSE_SHIFT)) | ((sense & EXTI_SENSE_MASK) << EXTI_INT0_SENSE_SHIFT);
+            error = E_OK;
+            break;
+        case EXTI_INT1:
+            MCUCR = (MCUCR & ~(EXTI_SENSE_MASK << EXTI_INT1_SENSE_SHIFT)) | ((sense & EXTI_SENSE_MASK) << EXTI_INT1_SENSE_SHIFT);
+            error = E_OK;
+            break;
+        case EXTI_INT2:
+            if(sense == EXTI_SENSE_FALLING)
+            {
+                MCUCSR &= ~EXTI_INT2_RISING;
+                error = E_OK;
+            }
+            else if(sense == EXTI_SENSE_RISING)
+            {
+                MCUCSR |= EXTI_INT2_RISING;
+                error = E_OK;
+            }
+            break;
+    }
+    if(error == E_OK)
+    {
+        EXTI_CLEAR_FLAG(Exti_bit[line]);
+    }
+    SREG = sreg;
+    return error;
+}
+
+/**
+ * Function:  Exti_Enable
+ * --------------------
+ *  @brief Enables the interrupt of a line
+ *         An event that happened while the line was disabled triggers it at once
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Exti_Enable(uint8_t line)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t sreg = SREG;
+    if(line < EXTI_NUMBER_OF_LINES)
+    {
+        SREG = sreg & GLOBAL_INT_DIS;
+        GICR |= Exti_bit[line];
+        SREG = sreg;
+        EXTI_SYNC(line);
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * Function:  Exti_Disable
+ * --------------------
+ *  @brief Disables the interrupt of a line
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Exti_Disable(uint8_t line)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t sreg = SREG;
+    if(line < EXTI_NUMBER_OF_LINES)
+    {
+        SREG = sreg & GLOBAL_INT_DIS;
+        GICR &= ~Exti_bit[line];
+        SREG = sreg;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * Function:  Exti_SetCallBack
+ * --------------------
+ *  @brief Sets the function called from the interrupt of a line
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  @param func: the callback function
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Exti_SetCallBack(uint8_t line, callback_t func)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(line < EXTI_NUMBER_OF_LINES)
+    {
+        Exti_func[line] = func;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief External Interrupt 0 Handler
+ *
+ */
+void __vector_1(void)
+{
+    if(Exti_func[EXTI_INT0])
+    {
+        Exti_func[EXTI_INT0]();
+    }
+}
+
+/**
+ * @brief External Interrupt 1 Handler
+ *
+ */
+void __vector_2(void)
+{
+    if(Exti_func[EXTI_INT1])
+    {
+        Exti_func[EXTI_INT1]();
+    }
+}
+
+/**
+ * @brief External Interrupt 2 Handler
+ *
+ */
+void __vector_3(void)
+{
+    if(Exti_func[EXTI_INT2])
+    {
+        Exti_func[EXTI_INT2]();
+    }
+}
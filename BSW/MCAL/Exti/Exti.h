@@ -0,0 +1,109 @@
+/**
+ * @file  Exti.h
+ * @brief This file is to be used as an interface for the user of the external interrupts driver.
+ *
+ * @author Mark Attia
+ * @date April 30, 2020
+ *
+ */
+#ifndef EXTI_H
+#define EXTI_H
+
+#define EXTI_INT0                       0
+#define EXTI_INT1                       1
+#define EXTI_INT2                       2
+#define EXTI_NUMBER_OF_LINES            3
+
+#define EXTI_SENSE_LOW_LEVEL            0
+#define EXTI_SENSE_ANY_CHANGE           1
+#define EXTI_SENSE_FALLING              2
+#define EXTI_SENSE_RISING               3
+
+/**
+ * Function:  Exti_GetLine
+ * --------------------
+ *  @brief Gets the external interrupt line of a pin
+ *         INT0 is on PD2, INT1 on PD3 and INT2 on PB2
+ *
+ *  @param port: The port of the pin
+ *                 @arg GPIO_PORTX : The port of the pin
+ *
+ *  @param pin: The pin
+ *                 @arg GPIO_PIN_X : The pin
+ *
+ *  @param line: To return the line in
+ *                 @arg EXTI_INTX : The line of the pin
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the pin has no external interrupt
+ */
+extern Std_ReturnType Exti_GetLine(uint8_t port, uint8_t pin, uint8_t* line);
+
+/**
+ * Function:  Exti_SetSense
+ * --------------------
+ *  @brief Sets the pin event that triggers a line
+ *         The flag of the line is cleared as changing the sense may raise it
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  @param sense: The event triggering the line
+ *                 @arg EXTI_SENSE_LOW_LEVEL : While the pin is low (INT0 and INT1)
+ *                 @arg EXTI_SENSE_ANY_CHANGE : On any edge (INT0 and INT1)
+ *                 @arg EXTI_SENSE_FALLING : On a falling edge
+ *                 @arg EXTI_SENSE_RISING : On a rising edge
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Exti_SetSense(uint8_t line, uint8_t sense);
+
+/**
+ * Function:  Exti_Enable
+ * --------------------
+ *  @brief Enables the interrupt of a line
+ *         An event that happened while the line was disabled triggers it at once
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Exti_Enable(uint8_t line);
+
+/**
+ * Function:  Exti_Disable
+ * --------------------
+ *  @brief Disables the interrupt of a line
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Exti_Disable(uint8_t line);
+
+/**
+ * Function:  Exti_SetCallBack
+ * --------------------
+ *  @brief Sets the function called from the interrupt of a line
+ *
+ *  @param line: The line
+ *                 @arg EXTI_INTX : The line
+ *
+ *  @param func: the callback function
+ *
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Exti_SetCallBack(uint8_t line, callback_t func);
+
+#endif
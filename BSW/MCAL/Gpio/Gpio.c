@@ -7,12 +7,42 @@
  *
  */
 #include "Std_Types.h"
+#include "Reg_Access.h"
 #include "Gpio.h"
 
 #define     GPIO_PIN                     0
 #define     GPIO_DDR                     1
 #define     GPIO_PORT                    2
 
+#define     GPIO_SREG                    REG8(0x5F)
+#define     GPIO_GLOBAL_INT_DIS          0x7F
+
+#define     GPIO_IS_PORT(port)           ((port) == GPIO_PORTA || (port) == GPIO_PORTB || \
+                                          (port) == GPIO_PORTC || (port) == GPIO_PORTD)
+
+#ifdef GPIO_HOST_BACKEND
+#include "GpioHost.h"
+#define     GPIO_SYNC(port)              GpioHost_Sync(port)
+#else
+#define     GPIO_SYNC(port)
+#endif
+
+/**
+ * @brief Changes some bits of a port register
+ *        The interrupts are masked so an interrupt writing the same register is not overwritten
+ *
+ * @param reg The address of the register
+ * @param mask The bits to change
+ * @param value The new value of the bits
+ */
+static void Gpio_UpdateRegister(uint8_t reg, uint8_t mask, uint8_t value)
+{
+    uint8_t sreg = GPIO_SREG;
+    GPIO_SREG = sreg & GPIO_GLOBAL_INT_DIS;
+    REG8(reg) = (REG8(reg) & ~mask) | (value & mask);
+    GPIO_SREG = sreg;
+}
+
 /**
  * Function:  Gpio_InitPins 
  * --------------------
@@ -28,21 +58,26 @@
 extern Std_ReturnType Gpio_InitPins(gpio_t* gpio)
 {
     Std_ReturnType err = E_NOT_OK;
-    switch(gpio->mode)
+    if(GPIO_IS_PORT(gpio->port))
     {
-        case GPIO_MODE_OUTPUT_PP:
-            *(uint8_t*)(gpio->port + GPIO_DDR) |= gpio->pins;
-            err = E_OK;
-            break;
-        case GPIO_MODE_INPUT_FLOAT:
-            *(uint8_t*)(gpio->port + GPIO_DDR) &= ~(gpio->pins);
-            err = E_OK;
-            break;
-        case GPIO_MODE_INPUT_PULLUP:
-            *(uint8_t*)(gpio->port + GPIO_PORT) |= gpio->pins;
-            *(uint8_t*)(gpio->port + GPIO_DDR) &= ~(gpio->pins);
-            err = E_OK;
-            break;
+        switch(gpio->mode)
+        {
+            case GPIO_MODE_OUTPUT_PP:
+                Gpio_UpdateRegister(gpio->port + GPIO_DDR, gpio->pins, GPIO_PIN_ALL);
+                err = E_OK;
+                break;
+            case GPIO_MODE_INPUT_FLOAT:
+                Gpio_UpdateRegister(gpio->port + GPIO_PORT, gpio->pins, 0);
+                Gpio_UpdateRegister(gpio->port + GPIO_DDR, gpio->pins, 0);
+                err = E_OK;
+                break;
+            case GPIO_MODE_INPUT_PULLUP:
+                Gpio_UpdateRegister(gpio->port + GPIO_PORT, gpio->pins, GPIO_PIN_ALL);
+                Gpio_UpdateRegister(gpio->port + GPIO_DDR, gpio->pins, 0);
+                err = E_OK;
+                break;
+        }
+        GPIO_SYNC(gpio->port);
     }
     return err;
 }
@@ -73,12 +108,10 @@ extern Std_ReturnType Gpio_WritePin(uint8_t port, uint8_t pin, uint8_t pinStatus
     switch(pinStatus)
     {
         case GPIO_PIN_SET:
-            *(uint8_t*)(port + GPIO_PORT) |= pin;
-            errorRet = E_OK;
+            errorRet = Gpio_WritePortMasked(port, pin, GPIO_PIN_ALL);
             break;
         case GPIO_PIN_RESET:
-            *(uint8_t*)(port + GPIO_PORT) &= ~pin;
-            errorRet = E_OK;
+            errorRet = Gpio_WritePortMasked(port, pin, 0);
             break;
     }
     return errorRet;
@@ -105,6 +138,66 @@ extern Std_ReturnType Gpio_WritePin(uint8_t port, uint8_t pin, uint8_t pinStatus
  */
 extern Std_ReturnType Gpio_ReadPin(uint8_t port, uint8_t pin, uint8_t* state)
 {
-    *state = !(*(uint8_t*)(GPIO_PIN + port) & pin);
-    return E_OK;
-}
\ No newline at end of file
+    uint8_t value;
+    Std_ReturnType errorRet = Gpio_ReadPort(port, &value);
+    if(errorRet == E_OK)
+    {
+        *state = !(value & pin);
+    }
+    return errorRet;
+}
+
+/**
+ * Function:  Gpio_ReadPort
+ * --------------------
+ *  @brief Reads the levels of all the pins of a port in one register access
+ *
+ *  @param port: The port you want to read from
+ *                 @arg GPIO_PORTX : The port you want to read from
+ *
+ *  @param value: To return the levels in, bit n is 1 if GPIO_PIN_n is high
+ *  @returns: A status
+ *              E_OK : if the function is executed correctly
+ *              E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Gpio_ReadPort(uint8_t port, uint8_t* value)
+{
+    Std_ReturnType errorRet = E_NOT_OK;
+    if(GPIO_IS_PORT(port))
+    {
+        *value = REG8(port + GPIO_PIN);
+        errorRet = E_OK;
+    }
+    return errorRet;
+}
+
+/**
+ * Function:  Gpio_WritePortMasked
+ * --------------------
+ *  @brief Writes the levels of some pins of a port in one register access
+ *         The other pins of the port keep their value
+ *
+ *  @param port: The port you want to write to
+ *                 @arg GPIO_PORTX : The port you want to write to
+ *
+ *  @param mask: The pins you want to write
+ *                 @arg GPIO_PIN_X : The pin number you want to write
+ *                 //You can OR more than one pin\\
+ *
+ *  @param value: The levels of the pins, bit n sets GPIO_PIN_n high when it is 1
+ *
+ *  @returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Gpio_WritePortMasked(uint8_t port, uint8_t mask, uint8_t value)
+{
+    Std_ReturnType errorRet = E_NOT_OK;
+    if(GPIO_IS_PORT(port))
+    {
+        Gpio_UpdateRegister(port + GPIO_PORT, mask, value);
+        GPIO_SYNC(port);
+        errorRet = E_OK;
+    }
+    return errorRet;
+}
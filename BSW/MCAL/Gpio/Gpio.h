@@ -41,6 +41,8 @@ typedef struct
 #define GPIO_PORTC                      0x33
 #define GPIO_PORTD                      0x30
 
+#define GPIO_NUMBER_OF_PORTS            4
+
 /**
  * Function:  Gpio_InitPins 
  * --------------------
@@ -98,4 +100,40 @@ extern Std_ReturnType Gpio_WritePin(uint8_t port, uint8_t pin, uint8_t pinStatus
  */
 extern Std_ReturnType Gpio_ReadPin(uint8_t port, uint8_t pin, uint8_t* state);
 
+/**
+ * Function:  Gpio_ReadPort 
+ * --------------------
+ *  @brief Reads the levels of all the pins of a port in one register access
+ *
+ *  @param port: The port you want to read from
+ *                 @arg GPIO_PORTX : The port you want to read from  
+ *
+ *  @param value: To return the levels in, bit n is 1 if GPIO_PIN_n is high
+ *  returns: A status
+ *              E_OK : if the function is executed correctly
+ *              E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Gpio_ReadPort(uint8_t port, uint8_t* value);
+
+/**
+ * Function:  Gpio_WritePortMasked 
+ * --------------------
+ *  @brief Writes the levels of some pins of a port in one register access
+ *         The other pins of the port keep their value
+ *
+ *  @param port: The port you want to write to
+ *                 @arg GPIO_PORTX : The port you want to write to  
+ * 
+ *  @param mask: The pins you want to write
+ *                 @arg GPIO_PIN_X : The pin number you want to write
+ *                 //You can OR more than one pin\
+ *
+ *  @param value: The levels of the pins, bit n sets GPIO_PIN_n high when it is 1
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Gpio_WritePortMasked(uint8_t port, uint8_t mask, uint8_t value);
+
 #endif
\ No newline at end of file
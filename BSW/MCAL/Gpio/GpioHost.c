@@ -0,0 +1,312 @@
+/**
+ * @file GpioHost.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the implementation for the host backend of the GPIO driver
+ *        It is only built with HOST_SIM and GPIO_HOST_BACKEND
+ *        Std_Types.h is not included because its fixed width types clash with the system headers
+ * @version 0.1
+ * @date 2020-04-30
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "GpioHost.h"
+
+#define GPIO_HOST_PIN               0
+#define GPIO_HOST_DDR               1
+#define GPIO_HOST_PORT              2
+
+/* The ports are 3 registers apart from PORTA down to PORTD */
+#define GPIO_HOST_PORTA             0x39
+#define GPIO_HOST_PORTD             0x30
+#define GPIO_HOST_NUMBER_OF_PORTS   4
+#define GPIO_HOST_INDEX(port)       ((GPIO_HOST_PORTA - (port)) / 3)
+
+#define GPIO_HOST_PORTB             0x36
+#define GPIO_HOST_MCUCSR            0x54
+#define GPIO_HOST_MCUCR             0x55
+#define GPIO_HOST_GIFR              0x5A
+#define GPIO_HOST_GICR              0x5B
+#define GPIO_HOST_SREG              0x5F
+#define GPIO_HOST_GIE               0x80
+#define GPIO_HOST_INT2_RISING       0x40
+#define GPIO_HOST_NUMBER_OF_LINES   3
+
+#define GPIO_HOST_SENSE_LOW_LEVEL   0
+#define GPIO_HOST_SENSE_ANY_CHANGE  1
+#define GPIO_HOST_SENSE_FALLING     2
+#define GPIO_HOST_SENSE_RISING      3
+
+typedef void (*hostVector_t)(void);
+
+/* A bouncing contact on some pins of a port */
+typedef struct
+{
+  unsigned char pins;
+  unsigned char levels;         /* The levels the pins settle on */
+  unsigned char old;            /* The levels before the contact moved */
+  unsigned int toggles;         /* The toggles left, a toggle leaving an odd count goes to the old levels */
+  unsigned long intervalUs;
+  unsigned long nextUs;
+} hostBounce_t;
+
+extern volatile unsigned char Sim_registers[];
+
+void __vector_1 (void);
+void __vector_2 (void);
+void __vector_3 (void);
+
+/* INT0 on PD2, INT1 on PD3 and INT2 on PB2 with their bit in GICR and GIFR */
+static const unsigned char hostLinePort[GPIO_HOST_NUMBER_OF_LINES] = {GPIO_HOST_PORTD, GPIO_HOST_PORTD, GPIO_HOST_PORTB};
+static const unsigned char hostLinePin[GPIO_HOST_NUMBER_OF_LINES] = {0x04, 0x08, 0x04};
+static const unsigned char hostLineBit[GPIO_HOST_NUMBER_OF_LINES] = {0x40, 0x80, 0x20};
+static const hostVector_t hostLineVector[GPIO_HOST_NUMBER_OF_LINES] = {__vector_1, __vector_2, __vector_3};
+
+static unsigned char hostDriven[GPIO_HOST_NUMBER_OF_PORTS];
+static unsigned char hostLevels[GPIO_HOST_NUMBER_OF_PORTS];
+static hostBounce_t hostBounce[GPIO_HOST_NUMBER_OF_PORTS];
+static unsigned long hostTimeUs;
+
+/**
+ * @brief Checks that an address is the base of a port
+ *
+ * @param port The address
+ * @return int Non zero if it is GPIO_PORTA to GPIO_PORTD
+ */
+static int GpioHost_IsPort(unsigned char port)
+{
+  return port >= GPIO_HOST_PORTD && port <= GPIO_HOST_PORTA && (GPIO_HOST_PORTA - port) % 3 == 0;
+}
+
+/**
+ * @brief Drives some input pins from outside like a switch would
+ *        A contact still bouncing on the pins stops
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins, bit n is GPIO_PIN_n
+ * @param levels The levels driven on the pins, bit n is 1 to drive GPIO_PIN_n high
+ */
+void GpioHost_Drive(unsigned char port, unsigned char pins, unsigned char levels)
+{
+  if (GpioHost_IsPort(port))
+  {
+    if (hostBounce[GPIO_HOST_INDEX(port)].pins & pins)
+    {
+      hostBounce[GPIO_HOST_INDEX(port)].toggles = 0;
+    }
+    hostDriven[GPIO_HOST_INDEX(port)] |= pins;
+    hostLevels[GPIO_HOST_INDEX(port)] = (hostLevels[GPIO_HOST_INDEX(port)] & ~pins) | (levels & pins);
+    GpioHost_Sync(port);
+  }
+}
+
+/**
+ * @brief Drives a bouncing contact from the current time of GpioHost_Advance
+ *        The pins go to the new levels at once, then every interval they go back to the levels they had
+ *        and to the new levels again until they bounced that many times
+ *        The toggles happen when the time is advanced past them, one at a time
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins, bit n is GPIO_PIN_n
+ * @param levels The levels the pins settle on
+ * @param bounces The number of times the pins go back to the old levels
+ * @param intervalUs The time between two toggles
+ */
+void GpioHost_Bounce(unsigned char port, unsigned char pins, unsigned char levels, unsigned int bounces,
+                     unsigned long intervalUs)
+{
+  hostBounce_t* bounce;
+  unsigned char old;
+  if (GpioHost_IsPort(port))
+  {
+    old = Sim_registers[port + GPIO_HOST_PIN] & pins;
+    GpioHost_Drive(port, pins, levels);
+    bounce = &hostBounce[GPIO_HOST_INDEX(port)];
+    bounce->pins = pins;
+    bounce->levels = levels & pins;
+    bounce->old = old;
+    bounce->toggles = bounces * 2;
+    bounce->intervalUs = intervalUs;
+    bounce->nextUs = hostTimeUs + intervalUs;
+  }
+}
+
+/**
+ * @brief Gets the port of the bouncing contact that toggles first
+ *
+ * @return int The index of the port or -1 if no contact is bouncing
+ */
+static int GpioHost_FirstBounce(void)
+{
+  int first = -1;
+  int itr;
+  for (itr = 0; itr < GPIO_HOST_NUMBER_OF_PORTS; itr++)
+  {
+    if (hostBounce[itr].toggles && (first < 0 || hostBounce[itr].nextUs < hostBounce[first].nextUs))
+    {
+      first = itr;
+    }
+  }
+  return first;
+}
+
+/**
+ * @brief Gets the time of the next toggle of a bouncing contact
+ *
+ * @param timeUs Save the time in
+ * @return int Non zero if a contact is still bouncing
+ */
+int GpioHost_NextToggle(unsigned long* timeUs)
+{
+  int first = GpioHost_FirstBounce();
+  if (first >= 0)
+  {
+    *timeUs = hostBounce[first].nextUs;
+  }
+  return first >= 0;
+}
+
+/**
+ * @brief Moves the time of the pins forward making the toggles of the bouncing contacts due until then
+ *        The caller runs the scheduler between two toggles by advancing to GpioHost_NextToggle first
+ *
+ * @param timeUs The new time
+ */
+void GpioHost_Advance(unsigned long timeUs)
+{
+  int first = GpioHost_FirstBounce();
+  hostBounce_t* bounce;
+  unsigned char port;
+  while (first >= 0 && hostBounce[first].nextUs <= timeUs)
+  {
+    bounce = &hostBounce[first];
+    port = (unsigned char)(GPIO_HOST_PORTA - first * 3);
+    hostTimeUs = bounce->nextUs;
+    bounce->toggles--;
+    hostLevels[first] = (hostLevels[first] & ~bounce->pins) | ((bounce->toggles & 1) ? bounce->old : bounce->levels);
+    bounce->nextUs += bounce->intervalUs;
+    GpioHost_Sync(port);
+    first = GpioHost_FirstBounce();
+  }
+  hostTimeUs = timeUs;
+}
+
+/**
+ * @brief Stops driving some pins, a released input reads its pull up or 0 when it floats
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The released pins, bit n is GPIO_PIN_n
+ */
+void GpioHost_Release(unsigned char port, unsigned char pins)
+{
+  if (GpioHost_IsPort(port))
+  {
+    hostDriven[GPIO_HOST_INDEX(port)] &= ~pins;
+    GpioHost_Sync(port);
+  }
+}
+
+/**
+ * @brief Gets the levels of the output pins of a port
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @return unsigned char The levels, bit n is 1 if GPIO_PIN_n is an output driven high
+ */
+unsigned char GpioHost_GetOutputs(unsigned char port)
+{
+  unsigned char levels = 0;
+  if (GpioHost_IsPort(port))
+  {
+    levels = Sim_registers[port + GPIO_HOST_DDR] & Sim_registers[port + GPIO_HOST_PORT];
+  }
+  return levels;
+}
+
+/**
+ * @brief Gets the event an external interrupt line is sensing
+ *
+ * @param line The line from INT0 to INT2
+ * @return unsigned char The GPIO_HOST_SENSE of the line
+ */
+static unsigned char GpioHost_GetSense(unsigned char line)
+{
+  unsigned char sense;
+  if (line == 2)
+  {
+    sense = (Sim_registers[GPIO_HOST_MCUCSR] & GPIO_HOST_INT2_RISING) ? GPIO_HOST_SENSE_RISING : GPIO_HOST_SENSE_FALLING;
+  }
+  else
+  {
+    sense = (Sim_registers[GPIO_HOST_MCUCR] >> (line * 2)) & 0x03;
+  }
+  return sense;
+}
+
+/**
+ * @brief Raises the flags of the external interrupts of a port on the edges of their pins
+ *        and calls the handlers of the enabled ones like the CPU would
+ *
+ * @param port The base address of the port
+ * @param old The levels of the pins before the update
+ */
+static void GpioHost_Interrupts(unsigned char port, unsigned char old)
+{
+  unsigned char line;
+  unsigned char sense;
+  unsigned char level;
+  unsigned char sreg;
+  int pending;
+  for (line = 0; line < GPIO_HOST_NUMBER_OF_LINES; line++)
+  {
+    if (hostLinePort[line] != port)
+    {
+      continue;
+    }
+    sense = GpioHost_GetSense(line);
+    level = Sim_registers[port + GPIO_HOST_PIN] & hostLinePin[line];
+    if ((old ^ Sim_registers[port + GPIO_HOST_PIN]) & hostLinePin[line])
+    {
+      if (sense == GPIO_HOST_SENSE_ANY_CHANGE || (sense == GPIO_HOST_SENSE_RISING && level) ||
+          (sense == GPIO_HOST_SENSE_FALLING && !level))
+      {
+        Sim_registers[GPIO_HOST_GIFR] |= hostLineBit[line];
+      }
+    }
+    pending = (sense == GPIO_HOST_SENSE_LOW_LEVEL) ? !level : (Sim_registers[GPIO_HOST_GIFR] & hostLineBit[line]) != 0;
+    sreg = Sim_registers[GPIO_HOST_SREG];
+    if (pending && (Sim_registers[GPIO_HOST_GICR] & hostLineBit[line]) && (sreg & GPIO_HOST_GIE))
+    {
+      /* The CPU clears the flag and the global interrupt enable while it runs the handler */
+      Sim_registers[GPIO_HOST_GIFR] &= ~hostLineBit[line];
+      Sim_registers[GPIO_HOST_SREG] = sreg & ~GPIO_HOST_GIE;
+      hostLineVector[line]();
+      Sim_registers[GPIO_HOST_SREG] |= GPIO_HOST_GIE;
+    }
+  }
+}
+
+/**
+ * @brief Updates PINx after the driver wrote DDRx or PORTx of a port
+ *        then calls the handler of every enabled external interrupt whose event happened
+ *        An output reads its PORTx bit, a driven input the driven level
+ *        and any other input its pull up
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ */
+void GpioHost_Sync(unsigned char port)
+{
+  unsigned char ddr;
+  unsigned char out;
+  unsigned char driven;
+  unsigned char old;
+  if (GpioHost_IsPort(port))
+  {
+    old = Sim_registers[port + GPIO_HOST_PIN];
+    ddr = Sim_registers[port + GPIO_HOST_DDR];
+    out = Sim_registers[port + GPIO_HOST_PORT];
+    driven = hostDriven[GPIO_HOST_INDEX(port)] & ~ddr;
+    Sim_registers[port + GPIO_HOST_PIN] = (ddr & out) | (driven & hostLevels[GPIO_HOST_INDEX(port)]) |
+                                          (~ddr & ~driven & out);
+    GpioHost_Interrupts(port, old);
+  }
+}
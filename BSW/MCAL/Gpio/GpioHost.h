@@ -0,0 +1,82 @@
+/**
+ * @file GpioHost.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the user interface for the host backend of the GPIO driver
+ *        It plays the pins of a HOST_SIM build on the register file so a test can drive the inputs
+ *        and check the outputs, PINx follows DDRx, PORTx and the levels driven from outside
+ *        It also raises the external interrupts INT0 to INT2 on the edges of their pins
+ *        It only uses plain C types so it can be included next to the system headers
+ * @version 0.1
+ * @date 2020-04-30
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#ifndef GPIO_HOST_H
+#define GPIO_HOST_H
+
+/**
+ * @brief Drives some input pins from outside like a switch would
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins, bit n is GPIO_PIN_n
+ * @param levels The levels driven on the pins, bit n is 1 to drive GPIO_PIN_n high
+ */
+extern void GpioHost_Drive(unsigned char port, unsigned char pins, unsigned char levels);
+
+/**
+ * @brief Drives a bouncing contact from the current time of GpioHost_Advance
+ *        The pins go to the new levels at once, then every interval they go back to the levels they had
+ *        and to the new levels again until they bounced that many times
+ *        The toggles happen when the time is advanced past them, one at a time
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins, bit n is GPIO_PIN_n
+ * @param levels The levels the pins settle on
+ * @param bounces The number of times the pins go back to the old levels
+ * @param intervalUs The time between two toggles
+ */
+extern void GpioHost_Bounce(unsigned char port, unsigned char pins, unsigned char levels, unsigned int bounces,
+                            unsigned long intervalUs);
+
+/**
+ * @brief Gets the time of the next toggle of a bouncing contact
+ *
+ * @param timeUs Save the time in
+ * @return int Non zero if a contact is still bouncing
+ */
+extern int GpioHost_NextToggle(unsigned long* timeUs);
+
+/**
+ * @brief Moves the time of the pins forward making the toggles of the bouncing contacts due until then
+ *        The caller runs the scheduler between two toggles by advancing to GpioHost_NextToggle first
+ *
+ * @param timeUs The new time
+ */
+extern void GpioHost_Advance(unsigned long timeUs);
+
+/**
+ * @brief Stops driving some pins, a released input reads its pull up or 0 when it floats
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The released pins, bit n is GPIO_PIN_n
+ */
+extern void GpioHost_Release(unsigned char port, unsigned char pins);
+
+/**
+ * @brief Gets the levels of the output pins of a port
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @return unsigned char The levels, bit n is 1 if GPIO_PIN_n is an output driven high
+ */
+extern unsigned char GpioHost_GetOutputs(unsigned char port);
+
+/**
+ * @brief Updates PINx after the driver wrote DDRx or PORTx of a port
+ *        then calls the handler of every enabled external interrupt whose event happened
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ */
+extern void GpioHost_Sync(unsigned char port);
+
+#endif
@@ -12,6 +12,7 @@
 #include "Sched_Cfg.h"
 #include "Sched.h"
 #include "Timer0.h"
+#include "Trace.h"
 
 #define SCHED_TASK_RUNNING               1
 #define SCHED_TASK_SUSPENDED             2
@@ -26,6 +27,7 @@ typedef struct
 } sysTask_t;
 
 extern const sysTaskInfo_t Sched_sysTaskInfo[SCHED_NUMBER_OF_TASKS];
+extern const callback_t Sched_modeSwitchCallBack;
 
 static sysTask_t Sched_task[SCHED_NUMBER_OF_TASKS];
 
@@ -33,6 +35,12 @@ static volatile uint8_t Sched_flag;
 
 static volatile uint8_t Sched_taskItr;
 
+static uint8_t Sched_mode;
+static uint8_t Sched_nextMode;
+
+/* Counted in the task context at the start of a tick so the tasks read it without masking the interrupts */
+static uint32_t Sched_timeMs;
+
 /**
  * @brief Sets the scheduler flag
  * 
@@ -42,9 +50,49 @@ static void Sched_SetFlag(void)
     Sched_flag = 1;
 }
 
+/**
+ * @brief Runs the tasks that are due in the current tick
+ *
+ */
+static void Sched_RunTick(void)
+{
+    Sched_timeMs += SCHED_TICK_TIME_MS;
+    if(Sched_nextMode != Sched_mode)
+    {
+        Sched_mode = Sched_nextMode;
+        TRACE(TRACE_EVENT_MODE_SWITCH, Sched_mode, 0);
+        if(Sched_modeSwitchCallBack)
+        {
+            Sched_modeSwitchCallBack();
+        }
+    }
+    for(Sched_taskItr=0; Sched_taskItr<SCHED_NUMBER_OF_TASKS; Sched_taskItr++)
+    {
+        if(SCHED_TASK_RUNNING == Sched_task[Sched_taskItr].state)
+        {
+                if(0 == Sched_task[Sched_taskItr].remainToExec)
+                {
+                    Sched_task[Sched_taskItr].remainToExec = Sched_task[Sched_taskItr].periodTicks;
+                    /* A task keeps its period in the modes it does not run in */
+                    if(Sched_task[Sched_taskItr].taskInfo->modes & SCHED_MODE(Sched_mode))
+                    {
+                        TRACE(TRACE_EVENT_TASK_START, Sched_taskItr, 0);
+                        Sched_task[Sched_taskItr].taskInfo->task->runnable();
+                        TRACE(TRACE_EVENT_TASK_STOP, Sched_taskItr, 0);
+                    }
+                }
+                /* A task activated while it ran is already due */
+                if(Sched_task[Sched_taskItr].remainToExec)
+                {
+                    Sched_task[Sched_taskItr].remainToExec--;
+                }
+        }
+    }
+}
+
 /**
  * @brief The scheduler that will run all the time
- * 
+ *
  */
 void Sched_Start(void)
 {
@@ -53,22 +101,27 @@ void Sched_Start(void)
         if(Sched_flag)
         {
             Sched_flag = 0;
-            for(Sched_taskItr=0; Sched_taskItr<SCHED_NUMBER_OF_TASKS; Sched_taskItr++)
-            {
-                if(SCHED_TASK_RUNNING == Sched_task[Sched_taskItr].state)
-                {
-                        if(0 == Sched_task[Sched_taskItr].remainToExec)
-                        {
-                            Sched_task[Sched_taskItr].remainToExec = Sched_task[Sched_taskItr].periodTicks;
-                            Sched_task[Sched_taskItr].taskInfo->task->runnable();
-                        }
-                        Sched_task[Sched_taskItr].remainToExec--;
-                }
-            }
+            Sched_RunTick();
         }
     }
 }
 
+#ifdef HOST_SIM
+/**
+ * @brief Runs the scheduler tick flagged by Timer0 if there is one
+ *        The host simulation calls it in place of Sched_Start to interleave the ECU images
+ *
+ */
+void Sched_Step(void)
+{
+    if(Sched_flag)
+    {
+        Sched_flag = 0;
+        Sched_RunTick();
+    }
+}
+#endif
+
 /**
  * @brief The initialization for the Scheduler
  * 
@@ -77,6 +130,7 @@ void Sched_Start(void)
 Std_ReturnType Sched_Init(void)
 {
     uint8_t i;
+    Sched_timeMs = SCHED_START_TIME_MS;
     for(i=0; i<SCHED_NUMBER_OF_TASKS; i++)
     {
         Sched_task[i].taskInfo = &Sched_sysTaskInfo[i];
@@ -105,6 +159,34 @@ Std_ReturnType Sched_SuspendTask(void)
     return E_OK;
 }
 
+/**
+ * @brief Makes a suspended task run again from the next tick
+ *        It may be called from an interrupt, a task that is running is left as it is
+ * 
+ * @param task The task to activate
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the task is not in the scheduler
+ */
+Std_ReturnType Sched_ActivateTask(const task_t* task)
+{
+    Std_ReturnType error = E_NOT_OK;
+    uint8_t i;
+    for(i=0; i<SCHED_NUMBER_OF_TASKS; i++)
+    {
+        if(Sched_sysTaskInfo[i].task == task)
+        {
+            if(SCHED_TASK_SUSPENDED == Sched_task[i].state)
+            {
+                Sched_task[i].remainToExec = 0;
+                Sched_task[i].state = SCHED_TASK_RUNNING;
+            }
+            error = E_OK;
+        }
+    }
+    return error;
+}
+
 /**
  * @brief Makes a task sleep for a while
  * 
@@ -119,3 +201,54 @@ Std_ReturnType Sched_Sleep(uint32_t timeMS)
     Sched_task[Sched_taskItr].remainToExec += times;
     return E_OK;
 }
+
+/**
+ * @brief Requests a mode switch
+ *        The scheduler switches at the start of the next tick so no task sees the mode change in
+ *        the middle of an activation, then it calls the mode switch callback of Sched_Cfg.c
+ *        The scheduler starts in mode 0
+ * 
+ * @param mode The new mode (less than SCHED_MAX_MODES)
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Sched_SwitchMode(uint8_t mode)
+{
+    Std_ReturnType error = E_NOT_OK;
+    if(mode < SCHED_MAX_MODES)
+    {
+        Sched_nextMode = mode;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Gets the current mode
+ * 
+ * @param mode Save the mode in
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Sched_GetMode(uint8_t* mode)
+{
+    *mode = Sched_mode;
+    return E_OK;
+}
+
+/**
+ * @brief Gets the time since the scheduler started
+ *        It advances by SCHED_TICK_TIME_MS at the start of every tick
+ * 
+ * @param timeMs Save the time in milli seconds in
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Sched_GetTimeMs(uint32_t* timeMs)
+{
+    *timeMs = Sched_timeMs;
+    return E_OK;
+}
@@ -13,6 +13,10 @@
 
 typedef void (*taskRunnable_t)(void);
 
+#define SCHED_MODE(mode)                 ((uint8_t)1 << (mode))
+#define SCHED_ALL_MODES                  0xFF
+#define SCHED_MAX_MODES                  8
+
 typedef struct
 {
     taskRunnable_t runnable;
@@ -24,6 +28,7 @@ typedef struct
 {
     const task_t* task;
     uint32_t delayTicks;
+    uint8_t modes; /* The SCHED_MODE of every mode the task runs in */
 } sysTaskInfo_t;
 
 /**
@@ -32,6 +37,15 @@ typedef struct
  */
 extern void Sched_Start(void);
 
+#ifdef HOST_SIM
+/**
+ * @brief Runs the scheduler tick flagged by Timer0 if there is one
+ *        The host simulation calls it in place of Sched_Start to interleave the ECU images
+ *
+ */
+extern void Sched_Step(void);
+#endif
+
 /**
  * @brief The initialization for the Scheduler
  * 
@@ -48,6 +62,17 @@ extern Std_ReturnType Sched_Init(void);
  */
 extern Std_ReturnType Sched_SuspendTask(void);
 
+/**
+ * @brief Makes a suspended task run again from the next tick
+ *        It may be called from an interrupt, a task that is running is left as it is
+ * 
+ * @param task The task to activate
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the task is not in the scheduler
+ */
+extern Std_ReturnType Sched_ActivateTask(const task_t* task);
+
 /**
  * @brief Makes a task sleep for a while
  * 
@@ -58,4 +83,39 @@ extern Std_ReturnType Sched_SuspendTask(void);
  */
 extern Std_ReturnType Sched_Sleep(uint32_t timeMS);
 
+/**
+ * @brief Requests a mode switch
+ *        The scheduler switches at the start of the next tick so no task sees the mode change in
+ *        the middle of an activation, then it calls the mode switch callback of Sched_Cfg.c
+ *        The scheduler starts in mode 0
+ * 
+ * @param mode The new mode (less than SCHED_MAX_MODES)
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Sched_SwitchMode(uint8_t mode);
+
+/**
+ * @brief Gets the current mode
+ * 
+ * @param mode Save the mode in
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Sched_GetMode(uint8_t* mode);
+
+/**
+ * @brief Gets the time since the scheduler started
+ *        It starts from SCHED_START_TIME_MS and advances by SCHED_TICK_TIME_MS at the start of every tick,
+ *        the users take differences so it may wrap
+ * 
+ * @param timeMs Save the time in milli seconds in
+ * @return Std_ReturnType 
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Sched_GetTimeMs(uint32_t* timeMs);
+
 #endif
\ No newline at end of file
@@ -12,17 +12,39 @@
 #include "Std_Types.h"
 #include "Sched_Cfg.h"
 #include "Sched.h"
+#include "Uart_Cfg.h"
+#include "Rte.h"
 
 extern const task_t AppInit_task,
 					Switch_task,
-                    Rte_task,
-                    Com_task;
+                    Rte_serverTask,
+                    Rte_fastTask,
+                    Rte_slowTask,
+                    Com_task,
+                    Tp_task,
+                    Led_task;
+
+extern void Rte_ModeSwitched(void);
+
+#if defined(FIRST_CONTROLLER_APP)
+/* The door ECU only watches its switches while the vehicle sleeps, an edge wakes it up (Rte_SwitchEdge) */
+#define SCHED_AWAKE_MODES       (SCHED_MODE(RTE_MODE_VEHICLE_MODE_RUN) | SCHED_MODE(RTE_MODE_VEHICLE_MODE_ACCESSORY))
+#else
+/* The dimmer ECU is woken up by the door Pdu so it keeps receiving and turns the lamp off while it sleeps */
+#define SCHED_AWAKE_MODES       SCHED_ALL_MODES
+#endif
 
 const sysTaskInfo_t Sched_sysTaskInfo[SCHED_NUMBER_OF_TASKS] = 
 {
-    /*Task                  First Delay*/
-	{&AppInit_task,             0       },
-    {&Com_task    ,             20      },
-    {&Switch_task,              20      },
-    {&Rte_task,                 20      }
+    /*Task                  First Delay         Modes*/
+	{&AppInit_task,             0,          SCHED_ALL_MODES },
+    {&UART_LINK_TASK,           20,         SCHED_AWAKE_MODES },
+    {&Switch_task,              20,         SCHED_ALL_MODES },
+    {&Rte_serverTask,           20,         SCHED_AWAKE_MODES },
+    {&Rte_fastTask,             20,         SCHED_AWAKE_MODES },
+    {&Rte_slowTask,             20,         SCHED_AWAKE_MODES },
+    {&Led_task,                 20,         SCHED_AWAKE_MODES }
 };
+
+/* The RTE updates its mode and the Pdus of the mode */
+const callback_t Sched_modeSwitchCallBack = Rte_ModeSwitched;
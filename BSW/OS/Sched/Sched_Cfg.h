@@ -11,10 +11,15 @@
 #ifndef SCHED_CFG_H
 #define SCHED_CFG_H
 
-#define SCHED_NUMBER_OF_TASKS             4
+#define SCHED_NUMBER_OF_TASKS             7
 
 #define SCHED_TICK_TIME_MS                5
 
 #define SCHED_SYS_CLK                     8000000
 
+/* The time Sched_GetTimeMs starts from, a build may start it near the wrap to check the users of the time */
+#ifndef SCHED_START_TIME_MS
+#define SCHED_START_TIME_MS               0
+#endif
+
 #endif
\ No newline at end of file
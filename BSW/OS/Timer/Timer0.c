@@ -8,18 +8,22 @@
  */
 #include "Std_Types.h"
 #include "Timer0.h"
+#include "Reg_Access.h"
 
-#define TCCR0               *(volatile uint8_t*)(0x53)
-#define TCNT0               *(volatile uint8_t*)(0x52)
-#define TIMSK               *(volatile uint8_t*)(0x59)
-#define OCR0                *(volatile uint8_t*)(0x5C)
-#define SREG                *(volatile uint8_t*)(0x5F)
+#define TCCR0               REG8(0x53)
+#define TCNT0               REG8(0x52)
+#define TIFR                REG8(0x58)
+#define TIMSK               REG8(0x59)
+#define OCR0                REG8(0x5C)
+#define SREG                REG8(0x5F)
 
 #define GLOBAL_INT_EN             0x80
 #define TMR0_INT_EN               0x01
 #define TMR0_INT_DIS              0xFE
 #define TMR0_CMP_INT_EN           0x02
 #define TMR0_CMP_INT_DIS          0xFD
+#define TMR0_CMP_FLAG             0x02
+#define GLOBAL_INT_DIS            0x7F
 #define TMR0_CLR_MODE			  0xB7
 #define TMR0_CRC_MODE             0x08
 #define TMR0_NORMAL_PORT_OP	      0xCF
@@ -27,6 +31,19 @@
 void __vector_10 (void) __attribute__ ((signal, used, externally_visible));
 
 callback_t Timer0_func = NULL;
+
+/* The time of the last compare match in micro seconds with its fraction in 1/65536 micro seconds
+   and a count and a whole period of the timer in 1/65536 micro seconds, so a timer clock above
+   1 MHz keeps its resolution, a count times 255 fits 32 bits down to a timer clock of 7.8 kHz */
+static volatile uint32_t Timer0_baseUs;
+static volatile uint16_t Timer0_baseFraction;
+static uint32_t Timer0_countFixed;
+static uint32_t Timer0_periodFixed;
+
+volatile uint32_t Timer0_ticks;
+
+#define TIMER0_FIXED_SHIFT        16
+#define TIMER0_FIXED_FRACTION     0xFFFFUL
 /**
  * Function:  Timer0_InterruptEnable 
  * --------------------
@@ -118,6 +135,42 @@ Std_ReturnType Timer0_GetValue(uint32_t* val)
     return E_OK;
 }
 
+/**
+ * Function:  Timer0_GetTimestampUs 
+ * --------------------
+ *  @brief Reads a free running time in micro seconds
+ *         The compare interrupt extends the counter by a period so no other timer is needed,
+ *         a compare match whose interrupt did not run yet is added while reading.
+ *         The resolution is a count of the timer and the time wraps after about 71 minutes
+ *
+ *  @param timeUs: a pointer to return the time in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer0_GetTimestampUs(uint32_t* timeUs)
+{
+    uint8_t sreg = SREG;
+    uint8_t count;
+    uint32_t base;
+    uint32_t fraction;
+    SREG = sreg & GLOBAL_INT_DIS;
+    count = TCNT0;
+    base = Timer0_baseUs;
+    fraction = Timer0_baseFraction;
+    if(TIFR & TMR0_CMP_FLAG)
+    {
+        /* The counter was cleared after the base, it is read again as the first read may be before the match */
+        count = TCNT0;
+        base += Timer0_periodFixed >> TIMER0_FIXED_SHIFT;
+        fraction += Timer0_periodFixed & TIMER0_FIXED_FRACTION;
+    }
+    SREG = sreg;
+    *timeUs = base + ((fraction + (uint32_t)count * Timer0_countFixed) >> TIMER0_FIXED_SHIFT);
+    return E_OK;
+}
+
 /**
  * Function:  Timer0_SetCallBack 
  * --------------------
@@ -150,10 +203,33 @@ Std_ReturnType Timer0_ClearValue(void)
     return E_OK;
 }
 
+/**
+ * Function:  Timer0_TicksToUs 
+ * --------------------
+ *  @brief Converts a time read as compare matches and a count of the timer to micro seconds
+ *         It gives the time Timer0_GetTimestampUs would have read at the same point
+ *
+ *  @param ticks: The compare matches of Timer0_ticks
+ *  @param count: The count of the timer after the last of them
+ *  @param timeUs: a pointer to return the time in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer0_TicksToUs(uint32_t ticks, uint8_t count, uint32_t* timeUs)
+{
+    /* The periods are summed in 64 bits so the fractions add up like they do in the interrupt */
+    *timeUs = (uint32_t)(((uint64_t)ticks * Timer0_periodFixed + (uint32_t)count * Timer0_countFixed) >> TIMER0_FIXED_SHIFT);
+    return E_OK;
+}
+
 /**
  * Function:  Timer0_SetTimeUS 
  * --------------------
  *  @brief Sets The reload time for timer 0
+ *         The time of a count for Timer0_GetTimestampUs is kept in 1/65536 micro seconds
+ *         so any timer clock from 7.8 kHz (8 MHz / 1024) up to 8 MHz (TMR0_DIV_1) is exact or close
  *
  *  @param timerClock: The Timer clock frequency
  *  @param timeUS: The time in Micro seconds
@@ -167,6 +243,9 @@ Std_ReturnType Timer0_SetTimeUS(f64 timerClock, uint32_t timeUS)
     f64 val;
     val = (f64)timerClock*(f64)timeUS/1000000.0;
     OCR0 = (uint8_t)val;
+    /* The counter runs from 0 to OCR0 so a period is one count more than OCR0 */
+    Timer0_countFixed = (uint32_t)(1000000.0 * (f64)(1UL << TIMER0_FIXED_SHIFT) / timerClock + 0.5);
+    Timer0_periodFixed = ((uint32_t)OCR0 + 1) * Timer0_countFixed;
 	return E_OK;
 }
 /**
@@ -175,7 +254,10 @@ Std_ReturnType Timer0_SetTimeUS(f64 timerClock, uint32_t timeUS)
  */
 void __vector_10(void)
 {
-	
+    uint32_t fraction = (uint32_t)Timer0_baseFraction + (Timer0_periodFixed & TIMER0_FIXED_FRACTION);
+    Timer0_baseUs += (Timer0_periodFixed >> TIMER0_FIXED_SHIFT) + (fraction >> TIMER0_FIXED_SHIFT);
+    Timer0_baseFraction = (uint16_t)(fraction & TIMER0_FIXED_FRACTION);
+    Timer0_ticks++;
     if(Timer0_func)
     {
         Timer0_func();
@@ -18,6 +18,9 @@
 #define TMR0_DIV_256			0x04
 #define TMR0_DIV_1024			0x05
 
+/* The compare matches since the start, counted by the compare interrupt
+   The trace reads it inline with TCNT0 and converts them later with Timer0_TicksToUs */
+extern volatile uint32_t Timer0_ticks;
 
 /**
  * Function:  Timer0_InterruptEnable 
@@ -64,6 +67,8 @@ extern Std_ReturnType Timer0_Start(uint8_t prescaler);
  * Function:  Timer0_SetTimeUS 
  * --------------------
  *  @brief Sets The reload time for timer 0
+ *         The time of a count for Timer0_GetTimestampUs is kept in 1/65536 micro seconds
+ *         so any timer clock from 7.8 kHz (8 MHz / 1024) up to 8 MHz (TMR0_DIV_1) is exact or close
  *
  *  @param timerClock: The Timer clock frequency
  *  @param timeUS: The time in Micro seconds
@@ -99,6 +104,22 @@ extern Std_ReturnType Timer0_Stop(void);
  */
 extern Std_ReturnType Timer0_GetValue(uint32_t* val);
 
+/**
+ * Function:  Timer0_GetTimestampUs 
+ * --------------------
+ *  @brief Reads a free running time in micro seconds
+ *         The compare interrupt extends the counter by a period so no other timer is needed,
+ *         a compare match whose interrupt did not run yet is added while reading.
+ *         The resolution is a count of the timer and the time wraps after about 71 minutes
+ *
+ *  @param timeUs: a pointer to return the time in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer0_GetTimestampUs(uint32_t* timeUs);
+
 /**
  * Function:  Timer0_SetCallBack 
  * --------------------
@@ -123,5 +144,21 @@ extern Std_ReturnType Timer0_SetCallBack(callback_t func);
  */
 extern Std_ReturnType Timer0_ClearValue(void);
 
+/**
+ * Function:  Timer0_TicksToUs 
+ * --------------------
+ *  @brief Converts a time read as compare matches and a count of the timer to micro seconds
+ *         It gives the time Timer0_GetTimestampUs would have read at the same point
+ *
+ *  @param ticks: The compare matches of Timer0_ticks
+ *  @param count: The count of the timer after the last of them
+ *  @param timeUs: a pointer to return the time in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer0_TicksToUs(uint32_t ticks, uint8_t count, uint32_t* timeUs);
+
 
 #endif
\ No newline at end of file
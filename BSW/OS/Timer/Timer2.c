@@ -0,0 +1,229 @@
+/**
+ * @file  Timer2.c 
+ * @brief This file is to be used as an implementation of the Timer 2 driver.
+ *
+ * @author Mark Attia
+ * @date April 30, 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Timer2.h"
+#include "Reg_Access.h"
+
+#define OCR2                REG8(0x43)
+#define TCNT2               REG8(0x44)
+#define TCCR2               REG8(0x45)
+#define TIMSK               REG8(0x59)
+#define SREG                REG8(0x5F)
+
+#define GLOBAL_INT_EN             0x80
+#define TMR2_OVF_INT_EN           0x40
+#define TMR2_OVF_INT_DIS          0xBF
+#define TMR2_CMP_INT_EN           0x80
+#define TMR2_CMP_INT_DIS          0x7F
+/* Normal mode with the OC2 pin disconnected */
+#define TMR2_NORMAL_MODE          0x00
+
+void __vector_4 (void) __attribute__ ((signal, used, externally_visible));
+void __vector_5 (void) __attribute__ ((signal, used, externally_visible));
+
+static callback_t Timer2_compareFunc = NULL;
+static callback_t Timer2_overflowFunc = NULL;
+
+/**
+ * Function:  Timer2_Start 
+ * --------------------
+ *  @brief Enables the Timer2 timer in normal mode
+ *  
+ *  @param prescaler: the division value for system clock
+ *					@arg TMR2_DIV_1
+ *					@arg TMR2_DIV_8
+ *					@arg TMR2_DIV_32
+ *     				@arg TMR2_DIV_64
+ *					@arg TMR2_DIV_128
+ *     				@arg TMR2_DIV_256
+ *					@arg TMR2_DIV_1024
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_Start(uint8_t prescaler)
+{
+    TCCR2 = TMR2_NORMAL_MODE | (prescaler & ~TMR2_PRESCALER_CLR);
+    TCNT2 = 0;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_Stop 
+ * --------------------
+ *  @brief Disables the Timer2 timer
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_Stop(void)
+{
+    TCCR2 &= TMR2_PRESCALER_CLR;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_GetValue 
+ * --------------------
+ *  @brief Reads the current value inside the Timer2 timer
+ *
+ *  @param val: a pointer to return data in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_GetValue(uint8_t* val)
+{
+    *val = TCNT2;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_SetCompare 
+ * --------------------
+ *  @brief Sets the count the compare match happens at
+ *
+ *  @param value: The compare count
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_SetCompare(uint8_t value)
+{
+    OCR2 = value;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_OverflowInterruptEnable 
+ * --------------------
+ *  @brief Enables the overflow interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_OverflowInterruptEnable(void)
+{
+    SREG |= GLOBAL_INT_EN;
+    TIMSK |= TMR2_OVF_INT_EN;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_OverflowInterruptDisable 
+ * --------------------
+ *  @brief Disables the overflow interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_OverflowInterruptDisable(void)
+{
+    TIMSK &= TMR2_OVF_INT_DIS;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_CompareInterruptEnable 
+ * --------------------
+ *  @brief Enables the compare match interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_CompareInterruptEnable(void)
+{
+    SREG |= GLOBAL_INT_EN;
+    TIMSK |= TMR2_CMP_INT_EN;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_CompareInterruptDisable 
+ * --------------------
+ *  @brief Disables the compare match interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_CompareInterruptDisable(void)
+{
+    TIMSK &= TMR2_CMP_INT_DIS;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_SetOverflowCallBack 
+ * --------------------
+ *  @brief Sets the callback function for the overflow of the Timer2
+ *
+ *  @param func: the callback function
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_SetOverflowCallBack(callback_t func)
+{
+    Timer2_overflowFunc = func;
+    return E_OK;
+}
+
+/**
+ * Function:  Timer2_SetCompareCallBack 
+ * --------------------
+ *  @brief Sets the callback function for the compare match of the Timer2
+ *
+ *  @param func: the callback function
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+Std_ReturnType Timer2_SetCompareCallBack(callback_t func)
+{
+    Timer2_compareFunc = func;
+    return E_OK;
+}
+
+/**
+ * @brief Timer 2 Compare Match Interrupt Handler
+ * 
+ */
+void __vector_4(void)
+{
+    if(Timer2_compareFunc)
+    {
+        Timer2_compareFunc();
+    }
+}
+
+/**
+ * @brief Timer 2 Overflow Interrupt Handler
+ * 
+ */
+void __vector_5(void)
+{
+    if(Timer2_overflowFunc)
+    {
+        Timer2_overflowFunc();
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file  Timer2.h 
+ * @brief This file is to be used as an interface for the user of Timer 2 driver.
+ *        The timer counts from 0 to 255 and calls back on its overflow and on its compare match
+ *
+ * @author Mark Attia
+ * @date April 30, 2020
+ *
+ */
+
+#ifndef TIMER2_H
+#define TIMER2_H
+
+#define TMR2_PRESCALER_CLR		0xF8
+
+#define TMR2_DIV_1				0x01
+#define TMR2_DIV_8				0x02
+#define TMR2_DIV_32				0x03
+#define TMR2_DIV_64				0x04
+#define TMR2_DIV_128			0x05
+#define TMR2_DIV_256			0x06
+#define TMR2_DIV_1024			0x07
+
+/**
+ * Function:  Timer2_Start 
+ * --------------------
+ *  @brief Enables the Timer2 timer in normal mode
+ *  
+ *  @param prescaler: the division value for system clock
+ *					@arg TMR2_DIV_1
+ *					@arg TMR2_DIV_8
+ *					@arg TMR2_DIV_32
+ *     				@arg TMR2_DIV_64
+ *					@arg TMR2_DIV_128
+ *     				@arg TMR2_DIV_256
+ *					@arg TMR2_DIV_1024
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_Start(uint8_t prescaler);
+
+/**
+ * Function:  Timer2_Stop 
+ * --------------------
+ *  @brief Disables the Timer2 timer
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_Stop(void);
+
+/**
+ * Function:  Timer2_GetValue 
+ * --------------------
+ *  @brief Reads the current value inside the Timer2 timer
+ *
+ *  @param val: a pointer to return data in
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_GetValue(uint8_t* val);
+
+/**
+ * Function:  Timer2_SetCompare 
+ * --------------------
+ *  @brief Sets the count the compare match happens at
+ *
+ *  @param value: The compare count
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_SetCompare(uint8_t value);
+
+/**
+ * Function:  Timer2_OverflowInterruptEnable 
+ * --------------------
+ *  @brief Enables the overflow interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_OverflowInterruptEnable(void);
+
+/**
+ * Function:  Timer2_OverflowInterruptDisable 
+ * --------------------
+ *  @brief Disables the overflow interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_OverflowInterruptDisable(void);
+
+/**
+ * Function:  Timer2_CompareInterruptEnable 
+ * --------------------
+ *  @brief Enables the compare match interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_CompareInterruptEnable(void);
+
+/**
+ * Function:  Timer2_CompareInterruptDisable 
+ * --------------------
+ *  @brief Disables the compare match interrupt for the Timer2
+ *
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_CompareInterruptDisable(void);
+
+/**
+ * Function:  Timer2_SetOverflowCallBack 
+ * --------------------
+ *  @brief Sets the callback function for the overflow of the Timer2
+ *
+ *  @param func: the callback function
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_SetOverflowCallBack(callback_t func);
+
+/**
+ * Function:  Timer2_SetCompareCallBack 
+ * --------------------
+ *  @brief Sets the callback function for the compare match of the Timer2
+ *
+ *  @param func: the callback function
+ *  
+ *  returns: A status
+ *                 E_OK : if the function is executed correctly
+ *                 E_NOT_OK : if the function is not executed correctly
+ */
+extern Std_ReturnType Timer2_SetCompareCallBack(callback_t func);
+
+
+#endif
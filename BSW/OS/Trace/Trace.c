@@ -0,0 +1,15 @@
+/**
+ * @file Trace.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the storage of the trace
+ *        Records are written inline by the TRACE macro of Trace.h
+ * @version 0.1
+ * @date 2020-04-29
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#include "Std_Types.h"
+#include "Trace.h"
+
+traceLog_t Trace_log;
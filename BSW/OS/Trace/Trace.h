@@ -0,0 +1,109 @@
+/**
+ * @file Trace.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the user interface for the trace
+ *        The scheduler and the RTE record their events in a ring buffer that always holds the last
+ *        TRACE_BUFFER_SIZE records. Dump Trace_log from the target and decode it on the host with
+ *        RTE/Generator/TraceDecode.py
+ * @version 0.1
+ * @date 2020-04-29
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "Reg_Access.h"
+#include "Timer0.h"
+#include "Trace_Cfg.h"
+
+/* The registers of Timer0 read by Trace_Record, it only reads them so it does not go through the driver */
+#define TRACE_TCNT0                     REG8(0x52)
+#define TRACE_TIFR                      REG8(0x58)
+#define TRACE_SREG                      REG8(0x5F)
+#define TRACE_GLOBAL_INT_DIS            0x7F
+#define TRACE_TMR0_CMP_FLAG             0x02
+
+/* Set in the last byte of the ticks of a record when the compare match of its count was not counted yet */
+#define TRACE_TICKS_PENDING             0x80
+
+#define TRACE_EVENT_NONE                0
+#define TRACE_EVENT_TASK_START          1
+#define TRACE_EVENT_TASK_STOP           2
+#define TRACE_EVENT_RUNNABLE_START      3
+#define TRACE_EVENT_RUNNABLE_STOP       4
+#define TRACE_EVENT_PORT_WRITE          5
+#define TRACE_EVENT_SEQUENCE_START      6
+#define TRACE_EVENT_SEQUENCE_END        7
+#define TRACE_EVENT_MODE_SWITCH         8
+
+/* Only bytes so the layout is the same on the target and on the host */
+typedef struct
+{
+    uint8_t event;
+    uint8_t id;
+    uint8_t data;
+    uint8_t count;      /* TCNT0 at the time of the event */
+    uint8_t ticks[3];   /* The low 23 bits of Timer0_ticks, the low byte first, and TRACE_TICKS_PENDING */
+} traceRecord_t;
+
+typedef struct
+{
+    uint8_t head;       /* The next record to write, which is also the oldest one */
+    traceRecord_t record[TRACE_BUFFER_SIZE];
+} traceLog_t;
+
+extern traceLog_t Trace_log;
+
+/**
+ * @brief Records an event with the current timestamp
+ *        The timestamp is the raw count and compare matches of Timer0 so a record is a few loads and stores,
+ *        they are converted to the micro seconds of Timer0_GetTimestampUs by Timer0_TicksToUs or TraceDecode.py
+ * 
+ * @param event The event
+ *              @arg TRACE_EVENT_TASK_START The scheduler starts a task, id is its index
+ *              @arg TRACE_EVENT_TASK_STOP The task returned
+ *              @arg TRACE_EVENT_RUNNABLE_START The RTE starts a runnable, id is its RTE_TRACE_ number
+ *              @arg TRACE_EVENT_RUNNABLE_STOP The runnable returned
+ *              @arg TRACE_EVENT_PORT_WRITE A port is written, id is its RTE_TRACE_ number and data the value
+ *              @arg TRACE_EVENT_SEQUENCE_START An input changed, data is the sequence tag it is sent with
+ *              @arg TRACE_EVENT_SEQUENCE_END An output was set for the input with the sequence tag in data
+ *              @arg TRACE_EVENT_MODE_SWITCH The scheduler switched to the mode in id
+ * @param id The task, runnable or port
+ * @param data The data of the event
+ */
+static inline void Trace_Record(uint8_t event, uint8_t id, uint8_t data)
+{
+    traceRecord_t* record = &Trace_log.record[Trace_log.head];
+    uint8_t sreg = TRACE_SREG;
+    uint8_t count;
+    uint8_t pending = 0;
+    uint32_t ticks;
+    TRACE_SREG = sreg & TRACE_GLOBAL_INT_DIS;
+    count = TRACE_TCNT0;
+    ticks = Timer0_ticks;
+    if(TRACE_TIFR & TRACE_TMR0_CMP_FLAG)
+    {
+        /* The counter was cleared after the ticks, it is read again as the first read may be before the match */
+        count = TRACE_TCNT0;
+        pending = TRACE_TICKS_PENDING;
+    }
+    TRACE_SREG = sreg;
+    record->count = count;
+    record->ticks[0] = (uint8_t)ticks;
+    record->ticks[1] = (uint8_t)(ticks >> 8);
+    record->ticks[2] = ((uint8_t)(ticks >> 16) & (uint8_t)~TRACE_TICKS_PENDING) | pending;
+    record->event = event;
+    record->id = id;
+    record->data = data;
+    Trace_log.head = (Trace_log.head + 1) & (TRACE_BUFFER_SIZE - 1);
+}
+
+#if TRACE_ENABLED
+#define TRACE(event, id, data)          Trace_Record(event, id, data)
+#else
+#define TRACE(event, id, data)
+#endif
+
+#endif
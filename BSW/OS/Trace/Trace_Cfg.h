@@ -0,0 +1,22 @@
+/**
+ * @file Trace_Cfg.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief These are the configurations for the trace
+ * @version 0.1
+ * @date 2020-04-29
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#ifndef TRACE_CFG_H
+#define TRACE_CFG_H
+
+/* Set to 0 to remove every trace point from the build */
+#define TRACE_ENABLED                   1
+
+/* The number of records kept, a power of two up to 128 (7 bytes of RAM each) */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE               32
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file Reg_Access.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the register access used by the drivers
+ *        On the target the registers are the memory mapped I/O of the ATMEGA32
+ *        When built with HOST_SIM the registers are a plain array owned by the host simulation
+ *        so every ECU image gets its own register file and the simulation can connect them
+ * @version 0.1
+ * @date 2020-04-26
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#ifndef REG_ACCESS_H
+#define REG_ACCESS_H
+
+#define REG_FILE_SIZE                   0x60
+
+#ifdef HOST_SIM
+extern volatile uint8_t Sim_registers[REG_FILE_SIZE];
+#define REG8(addr)                      (Sim_registers[(addr)])
+#else
+#define REG8(addr)                      (*(volatile uint8_t*)(addr))
+#endif
+
+#endif
@@ -7,6 +7,17 @@ typedef unsigned char                   u8;
 typedef unsigned char                   uint8_t;
 typedef signed char                     s8;
 typedef signed char                     sint8_t;
+#ifdef HOST_SIM
+/* The host simulation keeps the widths of the ATMEGA32 so the counters wrap like on the target */
+typedef unsigned short int              u16;
+typedef unsigned short int              uint16_t;
+typedef signed short int                s16;
+typedef signed short int                sint16_t;
+typedef unsigned int                    u32;
+typedef unsigned int                    uint32_t;
+typedef signed int                      s32;
+typedef signed int                      sint32_t;
+#else
 typedef unsigned       int              u16;
 typedef unsigned       int              uint16_t;
 typedef signed short int                s16;
@@ -15,6 +26,7 @@ typedef unsigned long int               u32;
 typedef unsigned long int               uint32_t;
 typedef signed long int                 s32;
 typedef signed long int                 sint32_t;
+#endif
 typedef unsigned long long int          u64;
 typedef unsigned long long int          uint64_t;
 typedef signed long long int            s64;
@@ -0,0 +1,978 @@
+#!/usr/bin/env python3
+"""
+@file RteGen.py
+@author Mark Attia (markjosephattia@gmail.com)
+@brief Generates the statically bound part of the RTE from the component and port description
+
+The generated Rte_Gen.h holds the port accessors as static inline functions, and Rte_Gen.c holds
+the storage of the ports and one scheduler task per RTE task calling its runnables directly.
+A runnable runs every activation of its task unless it has its own period, which must be a
+multiple of the task period. Inside a task a runnable writing a port runs before the runnables
+reading it, so a value crosses the whole chain in one activation.
+A port marked "queued" keeps every value sent in a single producer single consumer queue instead
+of the last one. The queue is sized from the writer and reader periods and the number of values
+the writer may send in one activation ("burst", 1 by default), with one more value of slack.
+Every slot is usable, a full queue refuses the value with RTE_E_LIMIT and the writer sends it again.
+A runnable listing ports in "events" is not run on time but only in the activations after one
+of these ports was written or sent to. A port with "activateOnChange" only triggers its readers
+when the written value differs from the stored one. Every event triggered runnable runs once in
+the first activation so the outputs start consistent with the inputs.
+A runnable listing client server operations of Rte.c in "returns" is triggered like by a port when one
+of these calls returns, Rte.c calls Rte_Return_<operation> once the server finished, so the client
+collects the result in the activation right after the server ran. An event triggered runnable that
+could not finish its work asks to run again in the next activation with Rte_Trigger_<component>.
+An event triggered runnable marked "alarm" can also ask to run at a time of Sched_GetTimeMs with
+Rte_SetAlarm_<component> and drop the request with Rte_CancelAlarm_<component>. The task only
+reads the time while an alarm is set, so a component waiting for nothing costs one test per activation.
+The components listed in the "implicit" of a port access it with Rte_IRead_/Rte_IWrite_. The task
+copies these ports to its buffer before each of their runnables and publishes the written ones
+after it, so a runnable sees one snapshot of its inputs and works on plain variables.
+The optional "mode" is a mode switch port written by its "manager" with Rte_Switch_. The scheduler
+applies the switch at the start of its next tick and calls Rte_ModeSwitched, which updates the
+mode of the RTE and, on the ECU of the manager, enables the Com Pdus listed for the new mode in
+"pdus" and writes the mode to the Com "signal". The other ECUs follow the mode they receive through
+Rte.c, so a runnable listing "modes" only runs in these modes whichever ECU it is mapped to.
+The first mode is the one the scheduler starts in.
+A port marked "boolean" carries 0 or 1 and is kept as one bit of the shared Rte_flags bytes, the other ports are
+stored in the smallest type holding their listed values. The data of each component is placed in
+its own .data.rte.<component> or .bss.rte.<component> section, run with --report to print the RAM
+and the flash (initial values) the RTE uses per component.
+Every runnable call and port write is traced, runnables and ports are numbered in the order of
+the description for BSW/OS/Trace and RTE/Generator/TraceDecode.py.
+The scheduler table of BSW/OS/Sched/Sched_Cfg.c is kept by hand, the generator checks that it
+schedules every RTE task once after Rte_serverTask, so a client collects its result in the tick its
+server ran, that SCHED_NUMBER_OF_TASKS matches the table and that the task periods are multiples
+of SCHED_TICK_TIME_MS. A build may run a task at another period by defining RTE_<TASK>_TASK_PERIOD_MS,
+the runnables with their own period keep the number of activations between their runs.
+Run it again every time RTE/Rte_Description.json changes:
+
+    python3 RTE/Generator/RteGen.py
+
+@version 0.1
+@date 2020-04-28
+
+@copyright Copyright (c) 2020
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+RTE_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+DESCRIPTION = os.path.join(RTE_DIR, "Rte_Description.json")
+OUT_HEADER = os.path.join(RTE_DIR, "Rte_Gen.h")
+OUT_SOURCE = os.path.join(RTE_DIR, "Rte_Gen.c")
+SCHED_DIR = os.path.join(RTE_DIR, "..", "BSW", "OS", "Sched")
+SCHED_CFG = os.path.join(SCHED_DIR, "Sched_Cfg.c")
+SCHED_CFG_HEADER = os.path.join(SCHED_DIR, "Sched_Cfg.h")
+SERVER_TASK = "Rte_serverTask"
+
+
+def file_header(name, brief):
+    return [
+        "/**",
+        " * @file %s" % name,
+        " * @author Mark Attia (markjosephattia@gmail.com)",
+        " * @brief %s" % brief,
+        " *        This file is generated by RTE/Generator/RteGen.py from RTE/Rte_Description.json, do not edit it",
+        " * @version 0.1",
+        " * @date 2020-04-28",
+        " * ",
+        " * @copyright Copyright (c) 2020",
+        " * ",
+        " */",
+    ]
+
+
+RETURN_OK = [
+    ("E_OK", "If the function executed successfully"),
+    ("E_NOT_OK", "If the function did not execute successfully"),
+]
+
+
+def doc_comment(brief, params, returns=RETURN_OK):
+    lines = ["/**", " * @brief %s" % brief, " * "]
+    for name, text, args in params:
+        lines.append(" * @param %s %s" % (name, text))
+        for arg, desc in args:
+            lines.append(" *              @arg %s %s" % (arg, desc))
+    if returns:
+        lines.append(" * @return Std_ReturnType ")
+        for code, desc in returns:
+            lines.append(" *              %s %s" % (code, desc))
+    lines.append(" */")
+    return lines
+
+
+def lower_first(name):
+    return name[0].lower() + name[1:]
+
+
+TYPE_SIZE = {"uint8_t": 1, "sint8_t": 1, "uint16_t": 2, "sint16_t": 2, "uint32_t": 4, "sint32_t": 4}
+
+RTE_OWNER = "Rte"
+
+
+def section(kind, owner):
+    return 'RTE_%s("%s")' % (kind, owner)
+
+
+def flag_macro(port):
+    return "RTE_FLAG_" + upper_snake(port["name"])
+
+
+def storage_type(port):
+    """The smallest type holding every listed value of a port"""
+    if len(port.get("args", [])) and len(port["args"]) <= 0x100:
+        return "uint8_t"
+    return port["type"]
+
+
+def storage_name(port):
+    return "Rte_" + lower_first(port["name"])
+
+
+def task_name(task):
+    return "Rte_" + lower_first(task["name"]) + "Task"
+
+
+def task_runnable_name(task):
+    return "Rte_" + task["name"] + "Runnable"
+
+
+def period_macro(task):
+    return "RTE_" + upper_snake(task["name"]) + "_TASK_PERIOD_MS"
+
+
+def divider_name(runnable):
+    return "Rte_" + lower_first(runnable["name"].replace("_", "")) + "Divider"
+
+
+def queue_type(port):
+    return "Rte_" + port["name"] + "QueueType"
+
+
+def upper_snake(name):
+    return "".join("_" + c if c.isupper() else c.upper() for c in name.replace("_", "")).lstrip("_")
+
+
+def queue_size_macro(port):
+    return "RTE_" + upper_snake(port["name"]) + "_QUEUE_SIZE"
+
+
+def buffer_type(task):
+    return "Rte_" + task["name"] + "BufferType"
+
+
+def buffer_name(task):
+    return "Rte_" + lower_first(task["name"]) + "Buffer"
+
+
+def trace_macro(item):
+    return "RTE_TRACE_" + upper_snake(item["name"])
+
+
+def mode_macro(mode, value):
+    return "RTE_MODE_%s_%s" % (upper_snake(mode["name"]), value)
+
+
+def modes_macro(runnable):
+    return "RTE_MODES_" + upper_snake(runnable["name"])
+
+
+def mode_mask(mode, values):
+    return "(%s)" % " | ".join("SCHED_MODE(%s)" % mode_macro(mode, value) for value in values)
+
+
+def events_name(task):
+    return "Rte_" + lower_first(task["name"]) + "Events"
+
+
+def event_macro(runnable):
+    return "RTE_EVENT_" + upper_snake(runnable["name"])
+
+
+def alarms_name(task):
+    return "Rte_" + lower_first(task["name"]) + "Alarms"
+
+
+def alarm_name(runnable):
+    return "Rte_" + lower_first(runnable["component"]) + "Alarm"
+
+
+class Description(object):
+    def __init__(self, path):
+        with open(path) as desc:
+            data = json.load(desc)
+        self.ecus = data["ecus"]
+        self.tasks = data["tasks"]
+        self.components = data["components"]
+        self.ports = data["ports"]
+        self.ecu_condition = dict((ecu["name"], ecu["condition"]) for ecu in self.ecus)
+        self.component_ecu = dict((comp["name"], comp["ecu"]) for comp in self.components)
+        self.task_period = dict((task["name"], task["period"]) for task in self.tasks)
+        self.mode = data.get("mode")
+        for comp in self.components:
+            for runnable in comp["runnables"]:
+                runnable["component"] = comp["name"]
+                runnable.setdefault("period", self.task_period.get(runnable["task"]))
+                runnable.setdefault("events", [])
+                runnable.setdefault("returns", [])
+                runnable.setdefault("modes", self.mode["values"] if self.mode else [])
+        self.check()
+
+    def check(self):
+        for comp in self.components:
+            if comp["ecu"] not in self.ecu_condition:
+                sys.exit("Component %s is mapped to unknown ECU %s" % (comp["name"], comp["ecu"]))
+            for runnable in comp["runnables"]:
+                if runnable["task"] not in self.task_period:
+                    sys.exit("Runnable %s is mapped to unknown task %s" % (runnable["name"], runnable["task"]))
+                if runnable["period"] % self.task_period[runnable["task"]]:
+                    sys.exit("The period of %s is not a multiple of its task period" % runnable["name"])
+                for port in self.ports:
+                    if comp["name"] in port.get("implicit", []) and runnable["task"] != self.implicit_task(port)["name"]:
+                        sys.exit("The implicit accesses of port %s are not in a single task" % port["name"])
+                for value in runnable["modes"]:
+                    if value not in self.mode["values"]:
+                        sys.exit("Runnable %s runs in unknown mode %s" % (runnable["name"], value))
+                if runnable.get("alarm") and not triggered(runnable):
+                    sys.exit("The alarm of %s needs a runnable triggered by events" % runnable["name"])
+                if runnable.get("alarm") and sum(1 for r in comp["runnables"] if r.get("alarm")) > 1:
+                    sys.exit("Component %s has more than one runnable with an alarm" % comp["name"])
+                if triggered(runnable) and sum(1 for r in comp["runnables"] if triggered(r)) > 1:
+                    sys.exit("Component %s has more than one runnable triggered by events" % comp["name"])
+                for port in runnable["events"]:
+                    if not any(p["name"] == port and comp["name"] in p["readers"] for p in self.ports):
+                        sys.exit("Runnable %s is triggered by port %s it does not read" % (runnable["name"], port))
+        for port in self.ports:
+            for comp in [port["writer"]] + port["readers"]:
+                if comp not in self.component_ecu:
+                    sys.exit("Port %s uses unknown component %s" % (port["name"], comp))
+            for comp in port.get("implicit", []):
+                if comp != port["writer"] and comp not in port["readers"]:
+                    sys.exit("Component %s does not access port %s" % (comp, port["name"]))
+            if port.get("boolean") and (port.get("queued") or len(port.get("args", [])) != 2):
+                sys.exit("The boolean port %s must be a last value port with two values" % port["name"])
+            if port.get("queued") and port.get("implicit"):
+                sys.exit("The queued port %s can not be accessed implicitly" % port["name"])
+            if port.get("queued") and len(port["readers"]) != 1:
+                sys.exit("The queued port %s must have a single reader" % port["name"])
+        if self.mode:
+            self.check_mode()
+
+    def check_mode(self):
+        if len(self.mode["values"]) > 8:
+            sys.exit("The mode %s has more than the 8 modes of the scheduler" % self.mode["name"])
+        if self.mode["manager"] not in self.component_ecu:
+            sys.exit("The mode %s is managed by unknown component %s" % (self.mode["name"], self.mode["manager"]))
+        for pdu, values in self.mode.get("pdus", {}).items():
+            for value in values:
+                if value not in self.mode["values"]:
+                    sys.exit("Pdu %s is enabled in unknown mode %s" % (pdu, value))
+
+    def mode_gated(self, runnable):
+        """If a runnable does not run in every mode"""
+        return self.mode is not None and len(runnable["modes"]) != len(self.mode["values"])
+
+    def event_runnables(self, task):
+        """The event triggered runnables of a task, each one owns a bit of the task events"""
+        result = [r for comp in self.components for r in comp["runnables"] if r["task"] == task["name"] and triggered(r)]
+        if len(result) > 32:
+            sys.exit("Task %s has more than 32 event triggered runnables" % task["name"])
+        return result
+
+    def alarm_runnables(self, task):
+        """The runnables of a task run by an alarm, an alarm sets the event of its runnable"""
+        return [r for r in self.event_runnables(task) if r.get("alarm")]
+
+    def implicit_task(self, port):
+        """The task of the runnables accessing a port implicitly"""
+        for comp in self.components:
+            if comp["name"] in port.get("implicit", []):
+                return [t for t in self.tasks if t["name"] == comp["runnables"][0]["task"]][0]
+        return None
+
+    def implicit_ports(self, task):
+        """The ports buffered by a task"""
+        return [p for p in self.ports if self.implicit_task(p) is task]
+
+    def flags(self):
+        """The boolean ports, eight of them share a byte of Rte_flags"""
+        return [p for p in self.ports if p.get("boolean")]
+
+    def flag_byte(self, port):
+        return "Rte_flags[%d]" % (self.flags().index(port) // 8)
+
+    def subscribers(self, port):
+        """The runnables triggered by a port with their task and ECU"""
+        result = []
+        for comp in self.components:
+            for runnable in comp["runnables"]:
+                if port["name"] in runnable["events"]:
+                    task = [t for t in self.tasks if t["name"] == runnable["task"]][0]
+                    result.append((runnable, task, self.ecu_condition[comp["ecu"]]))
+        return result
+
+    def operations(self):
+        """The client server operations some runnables are triggered by, in the order of the description"""
+        result = []
+        for comp in self.components:
+            for runnable in comp["runnables"]:
+                result += [op for op in runnable["returns"] if op not in result]
+        return result
+
+    def clients(self, operation):
+        """The runnables triggered by the return of an operation with their task and ECU"""
+        result = []
+        for comp in self.components:
+            for runnable in comp["runnables"]:
+                if operation in runnable["returns"]:
+                    task = [t for t in self.tasks if t["name"] == runnable["task"]][0]
+                    result.append((runnable, task, self.ecu_condition[comp["ecu"]]))
+        return result
+
+    def period(self, component):
+        """The shortest period of the runnables of a component"""
+        for comp in self.components:
+            if comp["name"] == component:
+                return min(r["period"] for r in comp["runnables"])
+
+    def queue_size(self, port):
+        """Room for everything the writer sends between two reads and one more, rounded to a power of two
+        The head and the tail count freely so no slot is kept empty to tell a full queue from an empty one"""
+        reads = -(-self.period(port["readers"][0]) // self.period(port["writer"]))
+        needed = reads * port.get("burst", 1) + 1
+        size = 2
+        while size < needed:
+            size *= 2
+        if size > 0x80:
+            sys.exit("The queue of port %s needs more than 128 entries" % port["name"])
+        return size
+
+    def runnables(self, ecu, task):
+        """The runnables of a task on an ECU with every port writer before its readers"""
+        pending = [r for comp in self.components if comp["ecu"] == ecu["name"]
+                   for r in comp["runnables"] if r["task"] == task["name"]]
+        mapped = set(r["component"] for r in pending)
+        ordered = []
+        while pending:
+            for runnable in pending:
+                waits = [port for port in self.ports
+                         if runnable["component"] in port["readers"] and port["writer"] in mapped
+                         and port["writer"] != runnable["component"]
+                         and any(r["component"] == port["writer"] for r in pending)]
+                if not waits:
+                    break
+            else:
+                sys.exit("The ports of task %s form a loop" % task["name"])
+            pending.remove(runnable)
+            ordered.append(runnable)
+        return ordered
+
+
+def gen_header(desc):
+    out = file_header("Rte_Gen.h", "These are the statically bound port accessors and runnable calls of the RTE")
+    out += ["#ifndef RTE_GEN_H", "#define RTE_GEN_H", "", '#include "Reg_Access.h"', '#include "Trace.h"', ""]
+
+    out += [
+        "/* Every component gets its own sections so the map file shows what it uses */",
+        '#define RTE_DATA(component)                     __attribute__((section(".data.rte." component)))',
+        '#define RTE_BSS(component)                      __attribute__((section(".bss.rte." component)))',
+        "",
+        "#define RTE_SREG                                REG8(0x5F)",
+        "#define RTE_GLOBAL_INT_DIS                      0x7F",
+        "",
+    ]
+    flags = desc.flags()
+    if flags:
+        for itr, port in enumerate(flags):
+            out.append("#define %s((uint8_t)1 << %d)" % (flag_macro(port).ljust(40), itr % 8))
+        out += ["", "extern uint8_t Rte_flags[%d];" % ((len(flags) + 7) // 8), ""]
+
+    for itr, runnable in enumerate(r for comp in desc.components for r in comp["runnables"]):
+        out.append("#define %s%d" % (trace_macro(runnable).ljust(40), itr))
+    out.append("")
+    for itr, port in enumerate(desc.ports):
+        out.append("#define %s%d" % (trace_macro(port).ljust(40), itr))
+    out.append("")
+
+    for port in desc.ports:
+        if port.get("queued"):
+            out += [
+                "#define %s%s" % (queue_size_macro(port).ljust(40), desc.queue_size(port)),
+                "",
+                "typedef struct",
+                "{",
+                "    volatile uint8_t head;      /* The values sent, the slot is the count modulo the size */",
+                "    volatile uint8_t tail;      /* The values received */",
+                "    volatile %s data[%s];" % (port["type"], queue_size_macro(port)),
+                "} %s;" % queue_type(port),
+                "",
+                "extern %s %s;" % (queue_type(port), storage_name(port)),
+                "",
+            ]
+        elif not port.get("boolean"):
+            out.append("extern %s %s;" % (storage_type(port), storage_name(port)))
+            out.append("")
+
+    for comp in desc.components:
+        for runnable in comp["runnables"]:
+            out += doc_comment("The runnable of the %s component" % comp["name"], [], returns=False)
+            out.append("extern void %s(void);" % runnable["name"])
+            out.append("")
+
+    out.append("/* The task periods of the description, a build may define others to run the same runnables slower or faster */")
+    for task in desc.tasks:
+        out += [
+            "#ifndef %s" % period_macro(task),
+            "#define %s%d" % (period_macro(task).ljust(40), task["period"]),
+            "#endif",
+        ]
+    out.append("")
+    for task in desc.tasks:
+        out.append("extern const task_t %s;" % task_name(task))
+    out.append("")
+
+    for task in desc.tasks:
+        runnables = desc.event_runnables(task)
+        if runnables:
+            for bit, runnable in enumerate(runnables):
+                out.append("#define %s%s" % (event_macro(runnable).ljust(40), "((%s)1 << %d)" % (events_type(runnables), bit)))
+            out += ["", "extern %s %s;" % (events_type(runnables), events_name(task)), ""]
+        alarms = desc.alarm_runnables(task)
+        if alarms:
+            out += ["extern %s %s;" % (events_type(runnables), alarms_name(task))]
+            out += ["extern uint32_t %s;" % alarm_name(r) for r in alarms]
+            out.append("")
+            for runnable in alarms:
+                out += gen_alarm_accessors(task, runnable)
+        for runnable in runnables:
+            out += gen_trigger_accessor(task, runnable)
+
+    for operation in desc.operations():
+        out += gen_return_accessor(desc, operation)
+
+    if desc.mode:
+        out += gen_mode_header(desc.mode)
+
+    for task in desc.tasks:
+        ports = desc.implicit_ports(task)
+        if ports:
+            out += ["typedef struct", "{"]
+            out += ["    %s %s;" % (p["type"], lower_first(p["name"])) for p in ports]
+            out += ["} %s;" % buffer_type(task), "", "extern %s %s;" % (buffer_type(task), buffer_name(task)), ""]
+
+    for port in desc.ports:
+        if port.get("queued"):
+            out += gen_queued_accessors(desc, port)
+        elif port.get("boolean"):
+            out += gen_flag_accessors(desc, port)
+        else:
+            out += gen_accessors(desc, port)
+        if port.get("implicit"):
+            out += gen_implicit_accessors(desc, port)
+
+    out += ["#endif"]
+    return out
+
+
+def events_type(runnables):
+    if len(runnables) <= 8:
+        return "uint8_t"
+    if len(runnables) <= 16:
+        return "uint16_t"
+    return "uint32_t"
+
+
+def gen_activation(desc, port, indent):
+    """Sets the events of the runnables triggered by a port"""
+    out = []
+    for runnable, task, condition in desc.subscribers(port):
+        out += ["#if %s" % condition, "%s%s |= %s;" % (indent, events_name(task), event_macro(runnable)), "#endif"]
+    return out
+
+
+def triggered(runnable):
+    """If a runnable runs on events instead of on time"""
+    return bool(runnable["events"] or runnable["returns"])
+
+
+def gen_trigger_accessor(task, runnable):
+    out = doc_comment("Runs %s again in the next activation of its task" % runnable["name"], [], returns=False)
+    out += [
+        "static inline void Rte_Trigger_%s(void)" % runnable["component"],
+        "{",
+        "    %s |= %s;" % (events_name(task), event_macro(runnable)),
+        "}",
+        "",
+    ]
+    return out
+
+
+def gen_return_accessor(desc, operation):
+    out = doc_comment("Called by Rte.c when the call of %s returns, triggers its clients" % operation, [], returns=False)
+    out += ["static inline void Rte_Return_%s(void)" % operation, "{"]
+    for runnable, task, condition in desc.clients(operation):
+        out += ["#if %s" % condition, "    %s |= %s;" % (events_name(task), event_macro(runnable)), "#endif"]
+    out += ["}", ""]
+    return out
+
+
+def gen_alarm_accessors(task, runnable):
+    alarms = alarms_name(task)
+    event = event_macro(runnable)
+    params = [("timeMs", "The time of Sched_GetTimeMs to run at", [])]
+    out = doc_comment("Runs %s once the scheduler time reaches a time, a new alarm replaces the set one"
+                      % runnable["name"], params)
+    out += [
+        "static inline Std_ReturnType Rte_SetAlarm_%s(uint32_t timeMs)" % runnable["component"],
+        "{",
+        "    %s = timeMs;" % alarm_name(runnable),
+        "    %s |= %s;" % (alarms, event),
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    out += doc_comment("Cancels the alarm set by Rte_SetAlarm_%s" % runnable["component"], [])
+    out += [
+        "static inline Std_ReturnType Rte_CancelAlarm_%s(void)" % runnable["component"],
+        "{",
+        "    %s &= ~%s;" % (alarms, event),
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    return out
+
+
+def gen_queued_accessors(desc, port):
+    var = storage_name(port)
+    mask = "(%s - 1)" % queue_size_macro(port)
+    params = [("status", port["param"], port["args"])]
+    out = doc_comment("Queues %s in the RTE" % port["brief"], params, [
+        ("E_OK", "If the value is queued"),
+        ("RTE_E_LIMIT", "If the queue is full, the value is not queued and is to be sent again"),
+    ])
+    out += [
+        "static inline Std_ReturnType Rte_Send_%s(%s status)" % (port["name"], port["type"]),
+        "{",
+        "    Std_ReturnType error = RTE_E_LIMIT;",
+        "    uint8_t head = %s.head;" % var,
+        "    if((uint8_t)(head - %s.tail) < %s)" % (var, queue_size_macro(port)),
+        "    {",
+        "        TRACE(TRACE_EVENT_PORT_WRITE, %s, (uint8_t)status);" % trace_macro(port),
+        "        %s.data[head & %s] = status;" % (var, mask),
+        "        %s.head = head + 1;" % var,
+        "        error = E_OK;",
+    ] + gen_activation(desc, port, "        ") + [
+        "    }",
+        "    return error;",
+        "}",
+        "",
+    ]
+    out += doc_comment("Takes the oldest %s queued in the RTE" % port["brief"], params, [
+        ("E_OK", "If a value is returned"),
+        ("RTE_E_NO_DATA", "If the queue is empty"),
+    ])
+    out += [
+        "static inline Std_ReturnType Rte_Receive_%s(%s* status)" % (port["name"], port["type"]),
+        "{",
+        "    Std_ReturnType error = RTE_E_NO_DATA;",
+        "    uint8_t tail = %s.tail;" % var,
+        "    if(tail != %s.head)" % var,
+        "    {",
+        "        *status = %s.data[tail & %s];" % (var, mask),
+        "        %s.tail = tail + 1;" % var,
+        "        error = E_OK;",
+        "    }",
+        "    return error;",
+        "}",
+        "",
+    ]
+    return out
+
+
+def gen_flag_accessors(desc, port):
+    var = desc.flag_byte(port)
+    flag = flag_macro(port)
+    params = [("status", port["param"], port["args"])]
+    out = doc_comment("Writes %s to the RTE" % port["brief"], params)
+    out += [
+        "static inline Std_ReturnType Rte_Write_%s(%s status)" % (port["name"], port["type"]),
+        "{",
+        "    uint8_t sreg = RTE_SREG;",
+        "    uint8_t flags;",
+        "    TRACE(TRACE_EVENT_PORT_WRITE, %s, (uint8_t)status);" % trace_macro(port),
+        "    /* The byte is shared with other ports so it is updated with the interrupts masked */",
+        "    RTE_SREG = sreg & RTE_GLOBAL_INT_DIS;",
+        "    flags = %s;" % var,
+        "    %s = status ? (flags | %s) : (flags & ~%s);" % (var, flag, flag),
+        "    RTE_SREG = sreg;",
+    ]
+    if port.get("activateOnChange") and desc.subscribers(port):
+        out += ["    if(((flags & %s) != 0) != (status != 0))" % flag, "    {"]
+        out += gen_activation(desc, port, "        ")
+        out += ["    }"]
+    else:
+        out += gen_activation(desc, port, "    ")
+    out += [
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    out += doc_comment("Reads %s from the RTE" % port["brief"], params)
+    out += [
+        "static inline Std_ReturnType Rte_Read_%s(%s* status)" % (port["name"], port["type"]),
+        "{",
+        "    *status = (%s & %s) != 0;" % (var, flag),
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    return out
+
+
+def gen_accessors(desc, port):
+    var = storage_name(port)
+    params = [("status", port["param"], port["args"])]
+    out = doc_comment("Writes %s to the RTE" % port["brief"], params)
+    out += [
+        "static inline Std_ReturnType Rte_Write_%s(%s status)" % (port["name"], port["type"]),
+        "{",
+        "    TRACE(TRACE_EVENT_PORT_WRITE, %s, (uint8_t)status);" % trace_macro(port),
+    ]
+    if port.get("activateOnChange") and desc.subscribers(port):
+        out += ["    if(%s != status)" % var, "    {", "        %s = status;" % var]
+        out += gen_activation(desc, port, "        ")
+        out += ["    }"]
+    else:
+        out += ["    %s = status;" % var]
+        out += gen_activation(desc, port, "    ")
+    out += [
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    out += doc_comment("Reads %s from the RTE" % port["brief"], params)
+    out += [
+        "static inline Std_ReturnType Rte_Read_%s(%s* status)" % (port["name"], port["type"]),
+        "{",
+        "    *status = (%s)%s;" % (port["type"], var),
+        "    return E_OK;",
+        "}",
+        "",
+    ]
+    return out
+
+
+def mode_name(mode):
+    return "Rte_" + lower_first(mode["name"])
+
+
+def gen_mode_header(mode):
+    var = mode_name(mode)
+    out = ["#define %s%d" % (mode_macro(mode, value).ljust(40), itr) for itr, value in enumerate(mode["values"])]
+    out += ["", "extern uint8_t %s;" % var, "extern uint8_t %sMask;" % var, ""]
+    params = [("mode", "The new mode", [(mode_macro(mode, value), "") for value in mode["values"]])]
+    out += doc_comment("Requests a switch of %s, the scheduler applies it at its next tick" % mode["brief"], params)
+    out = [line.rstrip() for line in out]
+    out += [
+        "static inline Std_ReturnType Rte_Switch_%s(uint8_t mode)" % mode["name"],
+        "{",
+        "    return Sched_SwitchMode(mode);",
+        "}",
+        "",
+    ]
+    comment = doc_comment("Gets %s" % mode["brief"], [], returns=False)
+    comment.insert(-1, " * @return uint8_t The current mode")
+    out += comment
+    out += [
+        "static inline uint8_t Rte_Mode_%s(void)" % mode["name"],
+        "{",
+        "    return %s;" % var,
+        "}",
+        "",
+    ]
+    out += doc_comment("Called by the scheduler after a mode switch", [], returns=False)
+    out += ["extern void Rte_ModeSwitched(void);", ""]
+    return out
+
+
+def gen_mode_source(desc, mode):
+    var = mode_name(mode)
+    out = [
+        "uint8_t %s %s = %s;" % (var, section("DATA", mode["manager"]), mode_macro(mode, mode["values"][0])),
+        "uint8_t %sMask %s = SCHED_MODE(%s);" % (var, section("DATA", mode["manager"]), mode_macro(mode, mode["values"][0])),
+        "",
+    ]
+    out += doc_comment("Called by the scheduler after a mode switch", [], returns=False)
+    out += [
+        "void Rte_ModeSwitched(void)",
+        "{",
+        "    Sched_GetMode(&%s);" % var,
+        "    %sMask = SCHED_MODE(%s);" % (var, var),
+    ]
+    if mode.get("pdus") or mode.get("signal"):
+        out.append("#if %s" % desc.ecu_condition[desc.component_ecu[mode["manager"]]])
+    if mode.get("signal"):
+        out.append("    Com_SendSignal(%s, (const void*)&%s);" % (mode["signal"], var))
+    for pdu, values in sorted(mode.get("pdus", {}).items()):
+        out += [
+            "    if(%sMask & %s)" % (var, mode_mask(mode, values)),
+            "    {",
+            "        Com_EnablePdu(%s);" % pdu,
+            "    }",
+            "    else",
+            "    {",
+            "        Com_DisablePdu(%s);" % pdu,
+            "    }",
+        ]
+    if mode.get("pdus") or mode.get("signal"):
+        out.append("#endif")
+    out += ["}", ""]
+    return out
+
+
+def gen_implicit_accessors(desc, port):
+    var = "%s.%s" % (buffer_name(desc.implicit_task(port)), lower_first(port["name"]))
+    params = [("status", port["param"], port["args"])]
+    out = []
+    if port["writer"] in port["implicit"]:
+        out += doc_comment("Writes %s to the task buffer, the RTE publishes it after the runnable" % port["brief"], params, returns=False)
+        out += [
+            "static inline void Rte_IWrite_%s(%s status)" % (port["name"], port["type"]),
+            "{",
+            "    %s = status;" % var,
+            "}",
+            "",
+        ]
+    if any(comp in port["readers"] for comp in port["implicit"]):
+        comment = doc_comment("Reads %s copied to the task buffer before the runnable" % port["brief"], [], returns=False)
+        comment.insert(-1, " * @return %s %s" % (port["type"], port["param"]))
+        out += comment
+        out += [
+            "static inline %s Rte_IRead_%s(void)" % (port["type"], port["name"]),
+            "{",
+            "    return %s;" % var,
+            "}",
+            "",
+        ]
+    return out
+
+
+def gen_call(desc, task, runnable, indent):
+    """Calls a runnable between the copies of its implicit ports"""
+    buffer = buffer_name(task)
+    ports = [p for p in desc.implicit_ports(task) if runnable["component"] in p["implicit"]]
+    out = ["%sRte_Read_%s(&%s.%s);" % (indent, p["name"], buffer, lower_first(p["name"])) for p in ports]
+    out += [
+        "%sTRACE(TRACE_EVENT_RUNNABLE_START, %s, 0);" % (indent, trace_macro(runnable)),
+        "%s%s();" % (indent, runnable["name"]),
+        "%sTRACE(TRACE_EVENT_RUNNABLE_STOP, %s, 0);" % (indent, trace_macro(runnable)),
+    ]
+    out += ["%sRte_Write_%s(%s.%s);" % (indent, p["name"], buffer, lower_first(p["name"]))
+            for p in ports if p["writer"] == runnable["component"]]
+    return out
+
+
+def divider_type(divider):
+    return "uint8_t" if divider <= 0xFF else "uint16_t"
+
+
+def gen_task(desc, task):
+    out = []
+    runnables = desc.event_runnables(task)
+    if desc.implicit_ports(task):
+        out.append("%s %s %s;" % (buffer_type(task), buffer_name(task), section("BSS", RTE_OWNER)))
+    if runnables:
+        out += ["%s %s %s = %s;" % (events_type(runnables), events_name(task), section("DATA", RTE_OWNER),
+                                     " | ".join(event_macro(r) for r in runnables))]
+    if desc.alarm_runnables(task):
+        out.append("%s %s %s;" % (events_type(runnables), alarms_name(task), section("BSS", RTE_OWNER)))
+        out += ["uint32_t %s %s;" % (alarm_name(r), section("BSS", r["component"])) for r in desc.alarm_runnables(task)]
+    for comp in desc.components:
+        for runnable in comp["runnables"]:
+            divider = runnable["period"] // task["period"]
+            if runnable["task"] == task["name"] and divider > 1 and not triggered(runnable):
+                out.append("static %s %s %s;" % (divider_type(divider), divider_name(runnable), section("BSS", RTE_OWNER)))
+    if out:
+        out.append("")
+    out += doc_comment("The %s RTE task running every %d ms" % (task["name"], task["period"]), [], returns=False)
+    out += ["static void %s(void)" % task_runnable_name(task), "{"]
+    for ecu in desc.ecus:
+        runnables = desc.runnables(ecu, task)
+        if not runnables:
+            continue
+        out.append("#if %s" % ecu["condition"])
+        for runnable in runnables:
+            divider = runnable["period"] // task["period"]
+            body = []
+            if runnable.get("alarm"):
+                body = [
+                    "if(%s & %s)" % (alarms_name(task), event_macro(runnable)),
+                    "{",
+                    "    uint32_t now;",
+                    "    Sched_GetTimeMs(&now);",
+                    "    /* The difference is signed so an alarm also expires across the wrap of the time */",
+                    "    if((sint32_t)(now - %s) >= 0)" % alarm_name(runnable),
+                    "    {",
+                    "        %s &= ~%s;" % (alarms_name(task), event_macro(runnable)),
+                    "        %s |= %s;" % (events_name(task), event_macro(runnable)),
+                    "    }",
+                    "}",
+                ]
+            if triggered(runnable):
+                body += [
+                    "if(%s & %s)" % (events_name(task), event_macro(runnable)),
+                    "{",
+                    "    %s &= ~%s;" % (events_name(task), event_macro(runnable)),
+                ] + gen_call(desc, task, runnable, "    ") + [
+                    "}",
+                ]
+            elif divider == 1:
+                body = gen_call(desc, task, runnable, "")
+            else:
+                body = [
+                    "if(++%s == %d)" % (divider_name(runnable), divider),
+                    "{",
+                    "    %s = 0;" % divider_name(runnable),
+                ] + gen_call(desc, task, runnable, "    ") + [
+                    "}",
+                ]
+            if desc.mode_gated(runnable):
+                # Pending events stay pending until the runnable runs in one of its modes again
+                body = ["if(%sMask & %s)" % (mode_name(desc.mode), modes_macro(runnable)), "{"] + \
+                       ["    " + line for line in body] + ["}"]
+            out += ["    " + line for line in body]
+        out.append("#endif")
+    out += ["}", "", "const task_t %s = {%s, %s};" % (task_name(task), task_runnable_name(task), period_macro(task)), ""]
+    return out
+
+
+def gen_source(desc):
+    out = file_header("Rte_Gen.c", "This is the storage of the RTE ports")
+    out += ['#include "Std_Types.h"', '#include "Sched.h"']
+    if desc.mode and (desc.mode.get("pdus") or desc.mode.get("signal")):
+        out += ['#include "Com.h"', '#include "Com_Cfg.h"']
+    out += ['#include "Rte.h"', ""]
+    gated = [r for comp in desc.components for r in comp["runnables"] if desc.mode_gated(r)]
+    for runnable in gated:
+        out.append("#define %s%s" % (modes_macro(runnable).ljust(40), mode_mask(desc.mode, runnable["modes"])))
+    if gated:
+        out.append("")
+    for port in desc.ports:
+        if port.get("queued"):
+            out.append("%s %s %s;" % (queue_type(port), storage_name(port), section("BSS", port["writer"])))
+        elif not port.get("boolean"):
+            out.append("%s %s %s = %s;" % (storage_type(port), storage_name(port), section("DATA", port["writer"]), port["init"]))
+    flags = desc.flags()
+    if flags:
+        init = []
+        for first in range(0, len(flags), 8):
+            init.append(" | ".join("(%s ? %s : 0)" % (p["init"], flag_macro(p)) for p in flags[first:first + 8]))
+        out.append("uint8_t Rte_flags[%d] %s = {%s};" % (len(init), section("DATA", RTE_OWNER), ", ".join(init)))
+    out.append("")
+    if desc.mode:
+        out += gen_mode_source(desc, desc.mode)
+    for task in desc.tasks:
+        out += gen_task(desc, task)
+    return out[:-1]
+
+
+def usage(desc):
+    """The RAM and the flash used by the RTE data of every component, as {owner: [ram, flash]}"""
+    result = {}
+
+    def add(owner, size, initialised):
+        entry = result.setdefault(owner, [0, 0])
+        entry[0] += size
+        if initialised:
+            entry[1] += size
+
+    for port in desc.ports:
+        if port.get("queued"):
+            add(port["writer"], 2 + desc.queue_size(port) * TYPE_SIZE[port["type"]], False)
+        elif not port.get("boolean"):
+            add(port["writer"], TYPE_SIZE[storage_type(port)], True)
+    add(RTE_OWNER, (len(desc.flags()) + 7) // 8, True)
+    if desc.mode:
+        add(desc.mode["manager"], 2, True)
+    for task in desc.tasks:
+        add(RTE_OWNER, sum(TYPE_SIZE[p["type"]] for p in desc.implicit_ports(task)), False)
+        runnables = desc.event_runnables(task)
+        if runnables:
+            add(RTE_OWNER, TYPE_SIZE[events_type(runnables)], True)
+        if desc.alarm_runnables(task):
+            add(RTE_OWNER, TYPE_SIZE[events_type(runnables)], False)
+        for runnable in desc.alarm_runnables(task):
+            add(runnable["component"], 4, False)
+        for comp in desc.components:
+            for runnable in comp["runnables"]:
+                divider = runnable["period"] // task["period"]
+                if runnable["task"] == task["name"] and divider > 1 and not triggered(runnable):
+                    add(RTE_OWNER, TYPE_SIZE[divider_type(divider)], False)
+    return result
+
+
+def report(desc):
+    print("RTE data per component (flash holds the initial values of .data)")
+    print("%-16s %-10s %8s %8s" % ("Component", "ECU", "RAM", "Flash"))
+    result = usage(desc)
+    for owner in [c["name"] for c in desc.components] + [RTE_OWNER]:
+        ram, flash = result.get(owner, [0, 0])
+        print("%-16s %-10s %8d %8d" % (owner, desc.component_ecu.get(owner, "both"), ram, flash))
+    for ecu in desc.ecus:
+        owners = [c["name"] for c in desc.components if c["ecu"] == ecu["name"]] + [RTE_OWNER]
+        print("%-16s %-10s %8d %8d" % ("Total", ecu["name"], sum(result.get(o, [0, 0])[0] for o in owners),
+                                        sum(result.get(o, [0, 0])[1] for o in owners)))
+
+
+def check_sched(desc):
+    """Checks the RTE tasks against the scheduler table of Sched_Cfg.c"""
+    with open(SCHED_CFG) as cfg:
+        table = re.search(r"Sched_sysTaskInfo\[.*?\]\s*=\s*\{(.*?)\};", cfg.read(), re.S)
+    with open(SCHED_CFG_HEADER) as cfg:
+        header = cfg.read()
+    scheduled = re.findall(r"\{\s*&\s*(\w+)\s*,", table.group(1)) if table else []
+    count = re.search(r"#define\s+SCHED_NUMBER_OF_TASKS\s+(\d+)", header)
+    tick = re.search(r"#define\s+SCHED_TICK_TIME_MS\s+(\d+)", header)
+    if not count or int(count.group(1)) != len(scheduled):
+        sys.exit("SCHED_NUMBER_OF_TASKS does not match the %d tasks of Sched_Cfg.c" % len(scheduled))
+    if SERVER_TASK not in scheduled:
+        sys.exit("%s is not scheduled in Sched_Cfg.c" % SERVER_TASK)
+    for task in desc.tasks:
+        name = task_name(task)
+        if scheduled.count(name) != 1:
+            sys.exit("%s must be scheduled once in Sched_Cfg.c, add {&%s, <first delay>, SCHED_ALL_MODES}"
+                     % (name, name))
+        if scheduled.index(name) < scheduled.index(SERVER_TASK):
+            sys.exit("%s must come after %s in Sched_Cfg.c" % (name, SERVER_TASK))
+        if not tick or task["period"] % int(tick.group(1)):
+            sys.exit("The period of task %s is not a multiple of SCHED_TICK_TIME_MS" % task["name"])
+    generated = set(task_name(task) for task in desc.tasks)
+    for name in scheduled:
+        if re.match(r"Rte_\w+Task$", name) and name != SERVER_TASK and name not in generated:
+            sys.exit("Sched_Cfg.c schedules %s which is not in the description" % name)
+
+
+def write(path, lines):
+    with open(path, "w", newline="") as out:
+        out.write("\r\n".join(lines) + "\r\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates the statically bound part of the RTE")
+    parser.add_argument("--report", action="store_true", help="print the RAM and flash of every component")
+    args = parser.parse_args()
+    desc = Description(DESCRIPTION)
+    check_sched(desc)
+    write(OUT_HEADER, gen_header(desc))
+    write(OUT_SOURCE, gen_source(desc))
+    if args.report:
+        report(desc)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+@file TraceDecode.py
+@author Mark Attia (markjosephattia@gmail.com)
+@brief Decodes trace dumps into a Chrome trace (chrome://tracing or ui.perfetto.dev)
+
+A dump is the raw memory of Trace_log (BSW/OS/Trace/Trace.h): the head byte followed by
+TRACE_BUFFER_SIZE records of 7 bytes, for example from avr-gdb:
+
+    dump binary value door.bin Trace_log
+
+Each dump becomes one process of the timeline, named after the part following a colon:
+
+    python3 RTE/Generator/TraceDecode.py door.bin:DoorEcu dimmer.bin:DimmerEcu -o trace.json
+
+Tasks are named from BSW/OS/Sched/Sched_Cfg.c, runnables and ports from RTE/Rte_Description.json.
+The task of the UART link is named after --uart-link, com unless the images were built with UART_LINK_TP.
+A record holds the count of Timer0 and the low 23 bits of its compare matches (Timer0_ticks), they are
+converted here to the micro seconds of Timer0_GetTimestampUs from SCHED_SYS_CLK and SCHED_TICK_TIME_MS
+of BSW/OS/Sched/Sched_Cfg.h. The compare matches wrap after about 11 hours at a tick of 5 ms.
+
+A door change is traced with the sequence tag the door PDU carries, and the lamp update on the
+other ECU with the tag it received. --latency pairs them and prints the latency distribution.
+The timestamps of the two ECUs count from their own reset, which the host simulation aligns.
+
+@version 0.1
+@date 2020-04-29
+
+@copyright Copyright (c) 2020
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+RTE_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+DESCRIPTION = os.path.join(RTE_DIR, "Rte_Description.json")
+SCHED_CFG = os.path.join(RTE_DIR, "..", "BSW", "OS", "Sched", "Sched_Cfg.c")
+SCHED_CFG_HEADER = os.path.join(RTE_DIR, "..", "BSW", "OS", "Sched", "Sched_Cfg.h")
+
+# The task UART_LINK_TASK of BSW/COM/Inc/Uart_Cfg.h is for every UART_LINK
+LINK_TASKS = {"com": "Com_task", "tp": "Tp_task"}
+
+RECORD_SIZE = 7
+
+EVENT_NONE = 0
+EVENT_TASK_START = 1
+EVENT_TASK_STOP = 2
+EVENT_RUNNABLE_START = 3
+EVENT_RUNNABLE_STOP = 4
+EVENT_PORT_WRITE = 5
+EVENT_SEQUENCE_START = 6
+EVENT_SEQUENCE_END = 7
+EVENT_MODE_SWITCH = 8
+
+# The width of DOOR_SEQUENCE_SIGNAL
+SEQUENCE_MASK = 0x7F
+HISTOGRAM_BINS = 10
+# The ticks of a record are 23 bits, the top bit of their last byte is TRACE_TICKS_PENDING
+TICKS_WRAP = 1 << 23
+TICKS_PENDING = 1 << 23
+# Sched_Init runs Timer0 from the system clock divided by 256 (TMR0_DIV_256)
+TIMER0_PRESCALER = 256
+# Timer0_SetTimeUS keeps the time of a count in 1/65536 micro seconds
+TIMER0_FIXED_SHIFT = 16
+
+
+def task_names(link):
+    with open(SCHED_CFG) as cfg:
+        tasks = re.findall(r"\{\s*&\s*(\w+)\s*,", cfg.read())
+    return [LINK_TASKS[link] if task == "UART_LINK_TASK" else task for task in tasks]
+
+
+def timer0_fixed():
+    """The time of a count and of a period of Timer0 in 1/65536 micro seconds, as Timer0_SetTimeUS sets them"""
+    with open(SCHED_CFG_HEADER) as cfg:
+        header = cfg.read()
+    clock = int(re.search(r"#define\s+SCHED_SYS_CLK\s+(\d+)", header).group(1)) / TIMER0_PRESCALER
+    tick_ms = int(re.search(r"#define\s+SCHED_TICK_TIME_MS\s+(\d+)", header).group(1))
+    count_fixed = int(1000000.0 * (1 << TIMER0_FIXED_SHIFT) / clock + 0.5)
+    # The counter runs from 0 to OCR0 so a period is one count more than OCR0
+    period_fixed = (int(clock * tick_ms * 1000 / 1000000.0) + 1) * count_fixed
+    return count_fixed, period_fixed
+
+
+def rte_names():
+    with open(DESCRIPTION) as desc:
+        desc = json.load(desc)
+    runnables = [r["name"] for comp in desc["components"] for r in comp["runnables"]]
+    ports = [p["name"] for p in desc["ports"]]
+    modes = desc["mode"]["values"] if "mode" in desc else []
+    return runnables, ports, modes
+
+
+def records(path):
+    """The records of a dump from the oldest to the newest"""
+    with open(path, "rb") as dump:
+        data = dump.read()
+    count = (len(data) - 1) // RECORD_SIZE
+    if len(data) != 1 + count * RECORD_SIZE or count & (count - 1):
+        sys.exit("%s is not a dump of Trace_log" % path)
+    head = data[0]
+    result = []
+    for itr in range(count):
+        offset = 1 + ((head + itr) % count) * RECORD_SIZE
+        event, ident, value, timer = data[offset:offset + 4]
+        ticks = int.from_bytes(data[offset + 4:offset + RECORD_SIZE], "little")
+        if event != EVENT_NONE:
+            # A compare match that was pending when the event was recorded is one more tick
+            ticks = (ticks & (TICKS_PENDING - 1)) + (1 if ticks & TICKS_PENDING else 0)
+            result.append((event, ident, value, ticks, timer))
+    return result
+
+
+def decode(path, pid, names):
+    tasks, runnables, ports, modes = names
+    count_fixed, period_fixed = timer0_fixed()
+    events = []
+    last = None
+    wraps = 0
+    for event, ident, value, ticks, timer in records(path):
+        ticks += wraps
+        if last is not None and last - ticks > TICKS_WRAP // 2:
+            # The 23 bit ticks wrapped
+            wraps += TICKS_WRAP
+            ticks += TICKS_WRAP
+        last = ticks
+        time_us = (ticks * period_fixed + timer * count_fixed) >> TIMER0_FIXED_SHIFT
+        entry = {"pid": pid, "tid": 0, "ts": time_us}
+        if event in (EVENT_TASK_START, EVENT_TASK_STOP):
+            entry["name"] = tasks[ident] if ident < len(tasks) else "Task %d" % ident
+            entry["cat"] = "task"
+            entry["ph"] = "B" if event == EVENT_TASK_START else "E"
+        elif event in (EVENT_RUNNABLE_START, EVENT_RUNNABLE_STOP):
+            entry["name"] = runnables[ident] if ident < len(runnables) else "Runnable %d" % ident
+            entry["cat"] = "runnable"
+            entry["ph"] = "B" if event == EVENT_RUNNABLE_START else "E"
+        elif event == EVENT_PORT_WRITE:
+            entry["name"] = ports[ident] if ident < len(ports) else "Port %d" % ident
+            entry["cat"] = "port"
+            entry["ph"] = "i"
+            entry["s"] = "p"
+            entry["args"] = {"value": value}
+        elif event == EVENT_MODE_SWITCH:
+            entry["name"] = modes[ident] if ident < len(modes) else "Mode %d" % ident
+            entry["cat"] = "mode"
+            entry["ph"] = "i"
+            entry["s"] = "g"
+        elif event in (EVENT_SEQUENCE_START, EVENT_SEQUENCE_END):
+            entry["name"] = "Sequence %d" % (value & SEQUENCE_MASK)
+            entry["cat"] = "sequence"
+            entry["ph"] = "s" if event == EVENT_SEQUENCE_START else "f"
+            entry["bp"] = "e"
+            entry["id"] = value & SEQUENCE_MASK
+        else:
+            continue
+        events.append(entry)
+    # The oldest records may end a slice that started before the buffer
+    depth = 0
+    result = []
+    for entry in events:
+        if entry["ph"] == "B":
+            depth += 1
+        elif entry["ph"] == "E":
+            if depth == 0:
+                continue
+            depth -= 1
+        result.append(entry)
+    return result
+
+
+def percentile(values, share):
+    return values[min(len(values) - 1, int(len(values) * share))]
+
+
+def latency(trace):
+    """Pairs every sequence end with the last start of its tag and prints the distribution"""
+    starts = {}
+    values = []
+    for entry in sorted((e for e in trace if e.get("cat") == "sequence"), key=lambda e: e["ts"]):
+        if entry["ph"] == "s":
+            starts[entry["id"]] = entry["ts"]
+        elif entry["id"] in starts:
+            values.append(entry["ts"] - starts.pop(entry["id"]))
+    if not values:
+        print("No door change reached the lamp in the dumps")
+        return
+    values.sort()
+    print("samples %d  p50 %.3f ms  p99 %.3f ms  max %.3f ms" % (
+        len(values), percentile(values, 0.5) / 1000, percentile(values, 0.99) / 1000, values[-1] / 1000))
+    width = max(values[-1] / HISTOGRAM_BINS, 1)
+    bins = [0] * HISTOGRAM_BINS
+    for value in values:
+        bins[min(HISTOGRAM_BINS - 1, int(value / width))] += 1
+    for itr, count in enumerate(bins):
+        print("%8.3f ms %6d %s" % (itr * width / 1000, count, "#" * (count * 50 // len(values))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes trace dumps into a Chrome trace")
+    parser.add_argument("dumps", nargs="+", help="dump files, each optionally followed by :name")
+    parser.add_argument("-o", "--output", default="trace.json", help="the Chrome trace file")
+    parser.add_argument("--latency", action="store_true", help="print the door to lamp latency")
+    parser.add_argument("--uart-link", choices=sorted(LINK_TASKS), default="com",
+                        help="the UART_LINK the images were built with")
+    args = parser.parse_args()
+
+    runnables, ports, modes = rte_names()
+    names = (task_names(args.uart_link), runnables, ports, modes)
+    trace = []
+    for pid, dump in enumerate(args.dumps):
+        path, _, name = dump.partition(":")
+        trace.append({"pid": pid, "tid": 0, "ph": "M", "name": "process_name",
+                      "args": {"name": name or os.path.basename(path)}})
+        trace += decode(path, pid, names)
+    with open(args.output, "w") as out:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, out, indent=1)
+    if args.latency:
+        latency(trace)
+
+
+if __name__ == "__main__":
+    main()
@@ -16,8 +16,10 @@
 #include "Com_Cfg.h"
 #include "Com.h"
 #include "Rte.h"
+#include "Trace.h"
 
-#define RTE_NUMBER_OF_MODULES       5
+/* The width of DOOR_SEQUENCE_SIGNAL, the 7 bits under the bit 7 of the second byte of the door Pdu */
+#define RTE_SEQUENCE_MASK   0x7F
 
 typedef struct
 {
@@ -25,259 +27,348 @@ typedef struct
     uint8_t data;
 } doorContact_t;
 
-static volatile uint8_t Rte_rightDoorStatus = DOOR_CLOSED;
-static volatile uint8_t Rte_leftDoorStatus = DOOR_CLOSED;
-static volatile uint32_t Rte_doorContactStatus = DOOR_CLOSED;
-static volatile uint8_t Rte_dimmerStatus = DIMMER_OFF;
+#define RTE_CALL_IDLE                   0
+#define RTE_CALL_PENDING                1
+#define RTE_CALL_DONE                   2
 
-static volatile runnable_t Rte_runnable[RTE_NUMBER_OF_MODULES];
+#define RTE_CALL_LEFT_DOOR_GET_STATUS   0
+#define RTE_CALL_RIGHT_DOOR_GET_STATUS  1
+#define RTE_CALL_LIGHTING_SET_LEVEL     2
+#define RTE_NUMBER_OF_CALLS             3
+
+/* The time the lamp takes to fade to a new level */
+#define RTE_LAMP_FADE_MS                500
+
+/* The period of the server task, a build may define another one to measure the latency of the calls */
+#ifndef RTE_SERVER_TASK_PERIOD_MS
+#define RTE_SERVER_TASK_PERIOD_MS       5
+#endif
+
+typedef Std_ReturnType (*Rte_ServerType)(uint8_t* data);
+typedef void (*Rte_ReturnType)(void);
+
+typedef struct
+{
+    uint8_t state;
+    uint8_t data;   /* The argument of the call, then the value returned by the server */
+    Std_ReturnType result;
+} Rte_CallType;
+
+static Std_ReturnType Rte_ServerLeftDoorGetStatus(uint8_t* status);
+static Std_ReturnType Rte_ServerRightDoorGetStatus(uint8_t* status);
+static Std_ReturnType Rte_ServerLightingSetLevel(uint8_t* level);
+
+static const Rte_ServerType Rte_server[RTE_NUMBER_OF_CALLS] = {
+    Rte_ServerLeftDoorGetStatus,
+    Rte_ServerRightDoorGetStatus,
+    Rte_ServerLightingSetLevel
+};
+
+/* Triggers the clients of an operation when its call returns */
+static const Rte_ReturnType Rte_return[RTE_NUMBER_OF_CALLS] = {
+    Rte_Return_LeftDoorGetStatus,
+    Rte_Return_RightDoorGetStatus,
+    Rte_Return_LightingSetLevel
+};
+
+static Rte_CallType Rte_call[RTE_NUMBER_OF_CALLS];
+
+/* The sequence tag of the last door change received from the COM */
+static uint8_t Rte_doorSequence;
 
 /**
- * @brief Calls the switch to get the hardware door status
+ * @brief Requests an operation from its server
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
+ * @param call The operation
+ * @param data The argument of the operation
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request of the operation is still pending
  */
-Std_ReturnType Rte_Call_LeftDoorGetStatus(uint8_t* status)
+static Std_ReturnType Rte_Request(uint8_t call, uint8_t data)
 {
-    Std_ReturnType error = E_NOT_OK;
-    error = Switch_GetSwitchStatus(LEFT_DOOR, status);
+    Std_ReturnType error = RTE_E_LIMIT;
+    if(Rte_call[call].state != RTE_CALL_PENDING)
+    {
+        Rte_call[call].data = data;
+        Rte_call[call].state = RTE_CALL_PENDING;
+        error = E_OK;
+    }
     return error;
 }
 
 /**
- * @brief Writes the door status to the RTE
+ * @brief Collects the result of a finished operation
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
+ * @param call The operation
+ * @param data The value returned by the server
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              The result of the server if the operation finished
+ *              RTE_E_NO_DATA If the operation was not requested or did not finish yet
  */
-Std_ReturnType Rte_Write_LeftDoorStatus(uint8_t status)
+static Std_ReturnType Rte_Collect(uint8_t call, uint8_t* data)
 {
-    Rte_leftDoorStatus = status;
-    return E_OK;
+    Std_ReturnType error = RTE_E_NO_DATA;
+    if(Rte_call[call].state == RTE_CALL_DONE)
+    {
+        *data = Rte_call[call].data;
+        error = Rte_call[call].result;
+        Rte_call[call].state = RTE_CALL_IDLE;
+    }
+    return error;
 }
 
 /**
- * @brief Calls the switch to get the hardware door status
+ * @brief Takes the edges a door switch queued since the last call
+ *        The gestures are not door changes and are skipped
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
+ * @param switchName The switch of the door
+ * @param status The status of the door after its last edge
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the door changed
+ *              RTE_E_NO_DATA If the switch had no edge
  */
-Std_ReturnType Rte_Call_RightDoorGetStatus(uint8_t* status)
+static Std_ReturnType Rte_DoorEdges(uint8_t switchName, uint8_t* status)
 {
-    Std_ReturnType error = E_NOT_OK;
-    error = Switch_GetSwitchStatus(RIGHT_DOOR, status);
+    Std_ReturnType error = RTE_E_NO_DATA;
+    switchEvent_t event;
+    while(Switch_GetEvent(switchName, &event) == E_OK)
+    {
+        if(event.edge == SWITCH_EDGE_PRESSED || event.edge == SWITCH_EDGE_RELEASED)
+        {
+            /* The switch is pressed while the door is closed */
+            *status = (event.edge == SWITCH_EDGE_PRESSED) ? DOOR_CLOSED : DOOR_OPEN;
+            error = E_OK;
+        }
+    }
     return error;
 }
 
 /**
- * @brief Writes the door status to the RTE
+ * @brief Takes the edges of the left door switch
  * 
  * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the door changed
+ *              RTE_E_NO_DATA If the switch had no edge, the call stays pending
  */
-Std_ReturnType Rte_Write_RightDoorStatus(uint8_t status)
+static Std_ReturnType Rte_ServerLeftDoorGetStatus(uint8_t* status)
 {
-    Rte_rightDoorStatus = status;
-    return E_OK;
+    return Rte_DoorEdges(LEFT_DOOR, status);
 }
 
 /**
- * @brief Reads the door status from the RTE
+ * @brief Takes the edges of the right door switch
  * 
  * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the door changed
+ *              RTE_E_NO_DATA If the switch had no edge, the call stays pending
  */
-Std_ReturnType Rte_Read_LeftDoorStatus(uint8_t* status)
+static Std_ReturnType Rte_ServerRightDoorGetStatus(uint8_t* status)
 {
-    *status = Rte_leftDoorStatus;
-    return E_OK;
+    return Rte_DoorEdges(RIGHT_DOOR, status);
 }
 
 /**
- * @brief Reads the door status from the RTE
+ * @brief Calls the Led to fade the hardware lamp to a brightness level
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
+ * @param level The brightness level of the lamp
  * @return Std_ReturnType 
  *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
  */
-Std_ReturnType Rte_Read_RightDoorStatus(uint8_t* status)
+static Std_ReturnType Rte_ServerLightingSetLevel(uint8_t* level)
 {
-    *status = Rte_rightDoorStatus;
-    return E_OK;    
+    Std_ReturnType error;
+    error = Led_SetLedLevel(DIMMER_LAMP, *level, RTE_LAMP_FADE_MS);
+    TRACE(TRACE_EVENT_SEQUENCE_END, DIMMER_LAMP, Rte_doorSequence);
+    return error;
 }
 
 /**
- * @brief Writes the dimmer status to the RTE
+ * @brief The server runnable that executes the pending operations
+ *        A server returning RTE_E_NO_DATA has nothing new and its call stays pending,
+ *        a finished call triggers its clients to collect the result
  * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
  */
-Std_ReturnType Rte_Write_DimmerStatus(uint8_t status)
+static void Rte_ServerRunnable(void)
 {
-    Rte_dimmerStatus = status;
-    return E_OK;
+    uint8_t call;
+    for(call = 0; call < RTE_NUMBER_OF_CALLS; call++)
+    {
+        if(Rte_call[call].state == RTE_CALL_PENDING)
+        {
+            Rte_call[call].result = Rte_server[call](&Rte_call[call].data);
+            if(Rte_call[call].result != RTE_E_NO_DATA)
+            {
+                Rte_call[call].state = RTE_CALL_DONE;
+                Rte_return[call]();
+            }
+        }
+    }
 }
 
+/* It runs before the RTE tasks in the same tick so a client is triggered in the activation right after its server ran */
+const task_t Rte_serverTask = {Rte_ServerRunnable, RTE_SERVER_TASK_PERIOD_MS};
+
 /**
- * @brief Reads the dimmer status from the RTE
+ * @brief Requests the next change of the door from the edges of its switch
+ *        The call returns at once and the status is collected with Rte_Result_LeftDoorGetStatus
+ *        once the switch had an edge
  * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-Std_ReturnType Rte_Read_DimmerStatus(uint8_t* status)
+Std_ReturnType Rte_Call_LeftDoorGetStatus(void)
 {
-    *status = Rte_dimmerStatus;
-    return E_OK;
+    return Rte_Request(RTE_CALL_LEFT_DOOR_GET_STATUS, 0);
 }
 
 /**
- * @brief Calls the Led to set the hardware lamp status
+ * @brief Collects the door change requested by Rte_Call_LeftDoorGetStatus
  * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
+ * @param status The status of the door after its last edge
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the status is returned
+ *              RTE_E_NO_DATA If the door did not change since the request
  */
-Std_ReturnType Rte_Call_LightingSetStatus(uint8_t status)
+Std_ReturnType Rte_Result_LeftDoorGetStatus(uint8_t* status)
 {
-    Std_ReturnType error = E_NOT_OK;
-    error = Led_SetLedStatus(DIMMER_LAMP, status);
-    return error;
+    return Rte_Collect(RTE_CALL_LEFT_DOOR_GET_STATUS, status);
 }
 
 /**
- * @brief Writes the door contact status
+ * @brief Requests the next change of the door from the edges of its switch
+ *        The call returns at once and the status is collected with Rte_Result_RightDoorGetStatus
+ *        once the switch had an edge
  * 
- * @param status The status of the door
- *              @arg DOOR_OPEN If the dimmer is on
- *              @arg DOOR_CLOSED If the dimmer is off
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-extern Std_ReturnType Rte_Write_DoorContactStatus(uint8_t status)
+Std_ReturnType Rte_Call_RightDoorGetStatus(void)
 {
-    Rte_doorContactStatus = status;
-    return E_OK;
+    return Rte_Request(RTE_CALL_RIGHT_DOOR_GET_STATUS, 0);
 }
 
 /**
- * @brief Sends Data of the door contact
+ * @brief Collects the door change requested by Rte_Call_RightDoorGetStatus
  * 
+ * @param status The status of the door after its last edge
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the status is returned
+ *              RTE_E_NO_DATA If the door did not change since the request
  */
-Std_ReturnType Rte_Call_DoorContactSendData(void)
+Std_ReturnType Rte_Result_RightDoorGetStatus(uint8_t* status)
 {
-    Std_ReturnType error;
-    error = Com_SendSignal(DOOR_STATE_SIGNAL, (const void*)&Rte_doorContactStatus);
-    return error;
+    return Rte_Collect(RTE_CALL_RIGHT_DOOR_GET_STATUS, status);
 }
 
 /**
- * @brief Receives Data for the dimmer
+ * @brief Requests the Led to fade the hardware lamp to a brightness level
+ *        The call returns at once and the fade is started by the server task
  * 
- * @param receiveID The ID of the data
- * @param data The Data to receive
+ * @param level The brightness level of the lamp from 0 to RTE_LAMP_LEVEL_MAX
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-Std_ReturnType Rte_Call_DimmerReceiveData(void)
+Std_ReturnType Rte_Call_LightingSetLevel(uint8_t level)
 {
-    Std_ReturnType error;
-    error = Com_ReceiveSignal(DOOR_STATE_SIGNAL, (void*)&Rte_doorContactStatus);;
-    return error;
+    return Rte_Request(RTE_CALL_LIGHTING_SET_LEVEL, level);
 }
 
 /**
- * @brief Receives Data for the dimmer
- * @param status The status of the door
- *              @arg DOOR_OPEN If the dimmer is on
- *              @arg DOOR_CLOSED If the dimmer is off
+ * @brief Collects the result of the lamp level requested by Rte_Call_LightingSetLevel
+ * 
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the lamp is set
+ *              E_NOT_OK If the Led did not set the lamp
+ *              RTE_E_NO_DATA If the request did not finish yet
  */
-Std_ReturnType Rte_Read_DoorContact(uint8_t* status)
+Std_ReturnType Rte_Result_LightingSetLevel(void)
 {
-    *status = Rte_doorContactStatus;
-    return E_OK;
+    uint8_t level;
+    return Rte_Collect(RTE_CALL_LIGHTING_SET_LEVEL, &level);
 }
 
 /**
- * @brief Sets the runnable for a certain module
+ * @brief Sends Data of the door contact
+ *        The sequence tag of the last door change is sent with it
  * 
- * @param runnable the runnable to set
- * @param module the module to set runnable to
  * @return Std_ReturnType 
  *              E_OK If the function executed successfully
  *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_SetRunnableEntity(runnable_t runnable, uint8_t module)
+Std_ReturnType Rte_Call_DoorContactSendData(void)
 {
-    Rte_runnable[module] = runnable;
-    return E_OK;
+    Std_ReturnType error;
+    uint8_t status;
+    uint8_t sequence;
+    Rte_Read_DoorContactStatus(&status);
+    Switch_GetSequence(&sequence);
+    sequence &= RTE_SEQUENCE_MASK;
+    error = Com_SendSignal(DOOR_STATE_SIGNAL, (const void*)&status);
+    if(error == E_OK)
+    {
+        error = Com_SendSignal(DOOR_SEQUENCE_SIGNAL, (const void*)&sequence);
+    }
+    return error;
 }
 
-
-static void Rte_Runnable(void)
+/**
+ * @brief Called by the COM when the door Pdu is received
+ *        Writes the door state to the dimmer port which triggers the dimmer when it changes
+ *        and switches to the vehicle mode of the door ECU
+ * 
+ */
+void Rte_ComCbk_DoorPdu(void)
 {
-    if(Rte_runnable[RTE_LEFT_DOOR_RUNNABLE])
-    {
-        Rte_runnable[RTE_LEFT_DOOR_RUNNABLE]();
-    }
-    if(Rte_runnable[RTE_RIGHT_DOOR_RUNNABLE])
+    uint8_t status;
+    uint8_t mode;
+    Com_ReceiveSignal(DOOR_SEQUENCE_SIGNAL, (void*)&Rte_doorSequence);
+    if(Com_ReceiveSignal(DOOR_STATE_SIGNAL, (void*)&status) == E_OK)
     {
-        Rte_runnable[RTE_RIGHT_DOOR_RUNNABLE]();
+        Rte_Write_DoorContactStatus(status);
     }
-    if(Rte_runnable[RTE_DOOR_CONTACT_RUNNABLE])
+    /* The door ECU is silent while it sleeps so another mode can only come from a corrupted Pdu */
+    if(Com_ReceiveSignal(VEHICLE_MODE_SIGNAL, (void*)&mode) == E_OK && mode < RTE_MODE_VEHICLE_MODE_SLEEP &&
+       mode != Rte_Mode_VehicleMode())
     {
-        Rte_runnable[RTE_DOOR_CONTACT_RUNNABLE]();
-    }
-    if(Rte_runnable[RTE_DIMMER_RUNNABLE])
-    {
-        Rte_runnable[RTE_DIMMER_RUNNABLE]();
-    }
-    if(Rte_runnable[RTE_LIGHTING_RUNNABLE])
-    {
-        Rte_runnable[RTE_LIGHTING_RUNNABLE]();
+        Rte_Switch_VehicleMode(mode);
     }
 }
 
-const task_t Rte_task = {Rte_Runnable, 40};
\ No newline at end of file
+/**
+ * @brief Called by the COM when the door Pdu was not received for its timeout
+ *        The door ECU only stops sending when the vehicle sleeps so the dimmer sleeps too
+ * 
+ */
+void Rte_ComTimeout_DoorPdu(void)
+{
+    Rte_Switch_VehicleMode(RTE_MODE_VEHICLE_MODE_SLEEP);
+}
+
+/**
+ * @brief Called by the switch driver when a switch has a new edge
+ *        The door ECU only watches its switches while the vehicle sleeps, so an edge wakes it up
+ *        to run and the mode manager picks the mode of the door contact in the next fast activation,
+ *        the edge itself stays queued until the server task takes it
+ * 
+ */
+void Rte_SwitchEdge(void)
+{
+#if defined(FIRST_CONTROLLER_APP)
+    if(Rte_Mode_VehicleMode() == RTE_MODE_VEHICLE_MODE_SLEEP)
+    {
+        Rte_Switch_VehicleMode(RTE_MODE_VEHICLE_MODE_RUN);
+        Rte_Trigger_ModeManager();
+    }
+#endif
+}
\ No newline at end of file
@@ -13,156 +13,123 @@
 
 #define DIMMER_ON       0
 #define DIMMER_OFF      !DIMMER_ON
+
+/* The brightness of the lamp in percent */
+#define RTE_LAMP_LEVEL_MAX  100
 #define DOOR_CLOSED     0
 #define DOOR_OPEN       !DOOR_CLOSED
 
 #define RTE_CONTACT_ID  0
 
-#define RTE_LEFT_DOOR_RUNNABLE              0
-#define RTE_RIGHT_DOOR_RUNNABLE             1
-#define RTE_DOOR_CONTACT_RUNNABLE           2
-#define RTE_DIMMER_RUNNABLE                 3
-#define RTE_LIGHTING_RUNNABLE               4
+#define RTE_E_LIMIT         130
+#define RTE_E_NO_DATA       131
 
-typedef void (*runnable_t)(void);
+#include "Rte_Gen.h"
 
 /**
- * @brief Calls the switch to get the hardware door status
+ * @brief Requests the next change of the door from the edges of its switch
+ *        The call returns at once and the status is collected with Rte_Result_LeftDoorGetStatus
+ *        once the switch had an edge
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-extern Std_ReturnType Rte_Call_LeftDoorGetStatus(uint8_t* status);
+extern Std_ReturnType Rte_Call_LeftDoorGetStatus(void);
 
 /**
- * @brief Writes the door status to the RTE
+ * @brief Collects the door change requested by Rte_Call_LeftDoorGetStatus
  * 
- * @param status The status of the door
+ * @param status The status of the door after its last edge
  *              @arg DOOR_CLOSED If the door is closed
  *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the status is returned
+ *              RTE_E_NO_DATA If the door did not change since the request
  */
-extern Std_ReturnType Rte_Write_LeftDoorStatus(uint8_t status);
+extern Std_ReturnType Rte_Result_LeftDoorGetStatus(uint8_t* status);
 
 /**
- * @brief Calls the switch to get the hardware door status
+ * @brief Requests the next change of the door from the edges of its switch
+ *        The call returns at once and the status is collected with Rte_Result_RightDoorGetStatus
+ *        once the switch had an edge
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-extern Std_ReturnType Rte_Call_RightDoorGetStatus(uint8_t* status);
+extern Std_ReturnType Rte_Call_RightDoorGetStatus(void);
 
 /**
- * @brief Writes the door status to the RTE
+ * @brief Collects the door change requested by Rte_Call_RightDoorGetStatus
  * 
- * @param status The status of the door
+ * @param status The status of the door after its last edge
  *              @arg DOOR_CLOSED If the door is closed
  *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the status is returned
+ *              RTE_E_NO_DATA If the door did not change since the request
  */
-extern Std_ReturnType Rte_Write_RightDoorStatus(uint8_t status);
+extern Std_ReturnType Rte_Result_RightDoorGetStatus(uint8_t* status);
 
 /**
- * @brief Reads the door status from the RTE
+ * @brief Requests the Led to fade the hardware lamp to a brightness level
+ *        The call returns at once and the fade is started by the server task
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
+ * @param level The brightness level of the lamp from 0 to RTE_LAMP_LEVEL_MAX
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the request is queued
+ *              RTE_E_LIMIT If the previous request is still pending
  */
-extern Std_ReturnType Rte_Read_LeftDoorStatus(uint8_t* status);
+extern Std_ReturnType Rte_Call_LightingSetLevel(uint8_t level);
 
 /**
- * @brief Reads the door status from the RTE
+ * @brief Collects the result of the lamp level requested by Rte_Call_LightingSetLevel
  * 
- * @param status The status of the door
- *              @arg DOOR_CLOSED If the door is closed
- *              @arg DOOR_OPEN If the door is open
  * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
+ *              E_OK If the lamp is set
+ *              E_NOT_OK If the Led did not set the lamp
+ *              RTE_E_NO_DATA If the request did not finish yet
  */
-extern Std_ReturnType Rte_Read_RightDoorStatus(uint8_t* status);
+extern Std_ReturnType Rte_Result_LightingSetLevel(void);
 
 /**
- * @brief Writes the dimmer status to the RTE
+ * @brief The task executing the pending client server operations
  * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_Write_DimmerStatus(uint8_t status);
+extern const task_t Rte_serverTask;
 
 /**
- * @brief Reads the dimmer status from the RTE
- * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
- */
-extern Std_ReturnType Rte_Read_DimmerStatus(uint8_t* status);
-
-/**
- * @brief Calls the Led to set the hardware lamp status
+ * @brief Sends Data of the door contact
+ *        The sequence tag of the last door change is sent with it
  * 
- * @param status The status of the door
- *              @arg DIMMER_ON If the dimmer is on
- *              @arg DIMMER_OF If the dimmer is off
  * @return Std_ReturnType 
  *              E_OK If the function executed successfully
  *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_Call_LightingSetStatus(uint8_t status);
+extern Std_ReturnType Rte_Call_DoorContactSendData(void);
 
 /**
- * @brief Writes the door contact status
+ * @brief Called by the COM when the door Pdu is received
+ *        Writes the door state to the dimmer port which triggers the dimmer when it changes
+ *        and switches to the vehicle mode of the door ECU
  * 
- * @param status The status of the door
- *              @arg DOOR_OPEN If the dimmer is on
- *              @arg DOOR_CLOSED If the dimmer is off
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_Write_DoorContactStatus(uint8_t status);
+extern void Rte_ComCbk_DoorPdu(void);
 
 /**
- * @brief Sends Data of the door contact
+ * @brief Called by the COM when the door Pdu was not received for its timeout
+ *        The door ECU only stops sending when the vehicle sleeps so the dimmer sleeps too
  * 
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_Call_DoorContactSendData(void);
+extern void Rte_ComTimeout_DoorPdu(void);
 
 /**
- * @brief Receives Data for the dimmer
+ * @brief Called by the switch driver when a switch has a new edge
+ *        The door ECU only watches its switches while the vehicle sleeps, so an edge wakes it up
  * 
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
  */
-extern Std_ReturnType Rte_Call_DimmerReceiveData(void);
+extern void Rte_SwitchEdge(void);
 
 /**
  * @brief Receives Data for the dimmer
@@ -173,26 +140,4 @@ extern Std_ReturnType Rte_Call_DimmerReceiveData(void);
  */
 extern Std_ReturnType Rte_Call_DimmerWriteData(void);
 
-/**
- * @brief Receives Data for the dimmer
- * @param status The status of the door
- *              @arg DOOR_OPEN If the dimmer is on
- *              @arg DOOR_CLOSED If the dimmer is off
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
- */
-extern Std_ReturnType Rte_Read_DoorContact(uint8_t* status);
-
-/**
- * @brief Sets the runnable for a certain module
- * 
- * @param runnable the runnable to set
- * @param module the module to set runnable to
- * @return Std_ReturnType 
- *              E_OK If the function executed successfully
- *              E_NOT_OK If the function executed successfully
- */
-extern Std_ReturnType Rte_SetRunnableEntity(runnable_t runnable, uint8_t module);
-
 #endif
\ No newline at end of file
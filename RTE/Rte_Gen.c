@@ -0,0 +1,148 @@
+/**
+ * @file Rte_Gen.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the storage of the RTE ports
+ *        This file is generated by RTE/Generator/RteGen.py from RTE/Rte_Description.json, do not edit it
+ * @version 0.1
+ * @date 2020-04-28
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#include "Std_Types.h"
+#include "Sched.h"
+#include "Com.h"
+#include "Com_Cfg.h"
+#include "Rte.h"
+
+#define RTE_MODES_MODE_MANAGER_SLEEP_RUNNABLE   (SCHED_MODE(RTE_MODE_VEHICLE_MODE_ACCESSORY))
+#define RTE_MODES_DIMMER_RUNNABLE               (SCHED_MODE(RTE_MODE_VEHICLE_MODE_RUN) | SCHED_MODE(RTE_MODE_VEHICLE_MODE_ACCESSORY))
+#define RTE_MODES_LIGHTING_RUNNABLE             (SCHED_MODE(RTE_MODE_VEHICLE_MODE_RUN) | SCHED_MODE(RTE_MODE_VEHICLE_MODE_ACCESSORY))
+
+Rte_LeftDoorStatusQueueType Rte_leftDoorStatus RTE_BSS("LeftDoor");
+Rte_RightDoorStatusQueueType Rte_rightDoorStatus RTE_BSS("RightDoor");
+uint8_t Rte_flags[1] RTE_DATA("Rte") = {(DOOR_CLOSED ? RTE_FLAG_DOOR_CONTACT_STATUS : 0) | (DIMMER_OFF ? RTE_FLAG_DIMMER_STATUS : 0)};
+
+uint8_t Rte_vehicleMode RTE_DATA("ModeManager") = RTE_MODE_VEHICLE_MODE_RUN;
+uint8_t Rte_vehicleModeMask RTE_DATA("ModeManager") = SCHED_MODE(RTE_MODE_VEHICLE_MODE_RUN);
+
+/**
+ * @brief Called by the scheduler after a mode switch
+ * 
+ */
+void Rte_ModeSwitched(void)
+{
+    Sched_GetMode(&Rte_vehicleMode);
+    Rte_vehicleModeMask = SCHED_MODE(Rte_vehicleMode);
+#if defined(FIRST_CONTROLLER_APP)
+    Com_SendSignal(VEHICLE_MODE_SIGNAL, (const void*)&Rte_vehicleMode);
+    if(Rte_vehicleModeMask & (SCHED_MODE(RTE_MODE_VEHICLE_MODE_RUN) | SCHED_MODE(RTE_MODE_VEHICLE_MODE_ACCESSORY)))
+    {
+        Com_EnablePdu(DOOR_PDU);
+    }
+    else
+    {
+        Com_DisablePdu(DOOR_PDU);
+    }
+#endif
+}
+
+Rte_FastBufferType Rte_fastBuffer RTE_BSS("Rte");
+uint8_t Rte_fastEvents RTE_DATA("Rte") = RTE_EVENT_LEFT_DOOR_RUNNABLE | RTE_EVENT_RIGHT_DOOR_RUNNABLE | RTE_EVENT_DOOR_CONTACT_RUNNABLE | RTE_EVENT_MODE_MANAGER_RUNNABLE | RTE_EVENT_DIMMER_RUNNABLE | RTE_EVENT_LIGHTING_RUNNABLE;
+uint8_t Rte_fastAlarms RTE_BSS("Rte");
+uint32_t Rte_dimmerAlarm RTE_BSS("Dimmer");
+
+/**
+ * @brief The Fast RTE task running every 10 ms
+ * 
+ */
+static void Rte_FastRunnable(void)
+{
+#if defined(FIRST_CONTROLLER_APP)
+    if(Rte_fastEvents & RTE_EVENT_LEFT_DOOR_RUNNABLE)
+    {
+        Rte_fastEvents &= ~RTE_EVENT_LEFT_DOOR_RUNNABLE;
+        TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_LEFT_DOOR_RUNNABLE, 0);
+        LeftDoor_Runnable();
+        TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_LEFT_DOOR_RUNNABLE, 0);
+    }
+    if(Rte_fastEvents & RTE_EVENT_RIGHT_DOOR_RUNNABLE)
+    {
+        Rte_fastEvents &= ~RTE_EVENT_RIGHT_DOOR_RUNNABLE;
+        TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_RIGHT_DOOR_RUNNABLE, 0);
+        RightDoor_Runnable();
+        TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_RIGHT_DOOR_RUNNABLE, 0);
+    }
+    if(Rte_fastEvents & RTE_EVENT_DOOR_CONTACT_RUNNABLE)
+    {
+        Rte_fastEvents &= ~RTE_EVENT_DOOR_CONTACT_RUNNABLE;
+        TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_DOOR_CONTACT_RUNNABLE, 0);
+        DoorContact_Runnable();
+        TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_DOOR_CONTACT_RUNNABLE, 0);
+    }
+    if(Rte_fastEvents & RTE_EVENT_MODE_MANAGER_RUNNABLE)
+    {
+        Rte_fastEvents &= ~RTE_EVENT_MODE_MANAGER_RUNNABLE;
+        TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_MODE_MANAGER_RUNNABLE, 0);
+        ModeManager_Runnable();
+        TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_MODE_MANAGER_RUNNABLE, 0);
+    }
+#endif
+#if !defined(FIRST_CONTROLLER_APP)
+    if(Rte_vehicleModeMask & RTE_MODES_DIMMER_RUNNABLE)
+    {
+        if(Rte_fastAlarms & RTE_EVENT_DIMMER_RUNNABLE)
+        {
+            uint32_t now;
+            Sched_GetTimeMs(&now);
+            /* The difference is signed so an alarm also expires across the wrap of the time */
+            if((sint32_t)(now - Rte_dimmerAlarm) >= 0)
+            {
+                Rte_fastAlarms &= ~RTE_EVENT_DIMMER_RUNNABLE;
+                Rte_fastEvents |= RTE_EVENT_DIMMER_RUNNABLE;
+            }
+        }
+        if(Rte_fastEvents & RTE_EVENT_DIMMER_RUNNABLE)
+        {
+            Rte_fastEvents &= ~RTE_EVENT_DIMMER_RUNNABLE;
+            Rte_Read_DoorContactStatus(&Rte_fastBuffer.doorContactStatus);
+            Rte_Read_DimmerStatus(&Rte_fastBuffer.dimmerStatus);
+            TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_DIMMER_RUNNABLE, 0);
+            Dimmer_Runnable();
+            TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_DIMMER_RUNNABLE, 0);
+            Rte_Write_DimmerStatus(Rte_fastBuffer.dimmerStatus);
+        }
+    }
+    if(Rte_vehicleModeMask & RTE_MODES_LIGHTING_RUNNABLE)
+    {
+        if(Rte_fastEvents & RTE_EVENT_LIGHTING_RUNNABLE)
+        {
+            Rte_fastEvents &= ~RTE_EVENT_LIGHTING_RUNNABLE;
+            Rte_Read_DimmerStatus(&Rte_fastBuffer.dimmerStatus);
+            TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_LIGHTING_RUNNABLE, 0);
+            Lighting_Runnable();
+            TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_LIGHTING_RUNNABLE, 0);
+        }
+    }
+#endif
+}
+
+const task_t Rte_fastTask = {Rte_FastRunnable, RTE_FAST_TASK_PERIOD_MS};
+
+/**
+ * @brief The Slow RTE task running every 100 ms
+ * 
+ */
+static void Rte_SlowRunnable(void)
+{
+#if defined(FIRST_CONTROLLER_APP)
+    if(Rte_vehicleModeMask & RTE_MODES_MODE_MANAGER_SLEEP_RUNNABLE)
+    {
+        TRACE(TRACE_EVENT_RUNNABLE_START, RTE_TRACE_MODE_MANAGER_SLEEP_RUNNABLE, 0);
+        ModeManager_SleepRunnable();
+        TRACE(TRACE_EVENT_RUNNABLE_STOP, RTE_TRACE_MODE_MANAGER_SLEEP_RUNNABLE, 0);
+    }
+#endif
+}
+
+const task_t Rte_slowTask = {Rte_SlowRunnable, RTE_SLOW_TASK_PERIOD_MS};
@@ -0,0 +1,517 @@
+/**
+ * @file Rte_Gen.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief These are the statically bound port accessors and runnable calls of the RTE
+ *        This file is generated by RTE/Generator/RteGen.py from RTE/Rte_Description.json, do not edit it
+ * @version 0.1
+ * @date 2020-04-28
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+#ifndef RTE_GEN_H
+#define RTE_GEN_H
+
+#include "Reg_Access.h"
+#include "Trace.h"
+
+/* Every component gets its own sections so the map file shows what it uses */
+#define RTE_DATA(component)                     __attribute__((section(".data.rte." component)))
+#define RTE_BSS(component)                      __attribute__((section(".bss.rte." component)))
+
+#define RTE_SREG                                REG8(0x5F)
+#define RTE_GLOBAL_INT_DIS                      0x7F
+
+#define RTE_FLAG_DOOR_CONTACT_STATUS            ((uint8_t)1 << 0)
+#define RTE_FLAG_DIMMER_STATUS                  ((uint8_t)1 << 1)
+
+extern uint8_t Rte_flags[1];
+
+#define RTE_TRACE_LEFT_DOOR_RUNNABLE            0
+#define RTE_TRACE_RIGHT_DOOR_RUNNABLE           1
+#define RTE_TRACE_DOOR_CONTACT_RUNNABLE         2
+#define RTE_TRACE_MODE_MANAGER_RUNNABLE         3
+#define RTE_TRACE_MODE_MANAGER_SLEEP_RUNNABLE   4
+#define RTE_TRACE_DIMMER_RUNNABLE               5
+#define RTE_TRACE_LIGHTING_RUNNABLE             6
+
+#define RTE_TRACE_LEFT_DOOR_STATUS              0
+#define RTE_TRACE_RIGHT_DOOR_STATUS             1
+#define RTE_TRACE_DOOR_CONTACT_STATUS           2
+#define RTE_TRACE_DIMMER_STATUS                 3
+
+#define RTE_LEFT_DOOR_STATUS_QUEUE_SIZE         2
+
+typedef struct
+{
+    volatile uint8_t head;      /* The values sent, the slot is the count modulo the size */
+    volatile uint8_t tail;      /* The values received */
+    volatile uint8_t data[RTE_LEFT_DOOR_STATUS_QUEUE_SIZE];
+} Rte_LeftDoorStatusQueueType;
+
+extern Rte_LeftDoorStatusQueueType Rte_leftDoorStatus;
+
+#define RTE_RIGHT_DOOR_STATUS_QUEUE_SIZE        2
+
+typedef struct
+{
+    volatile uint8_t head;      /* The values sent, the slot is the count modulo the size */
+    volatile uint8_t tail;      /* The values received */
+    volatile uint8_t data[RTE_RIGHT_DOOR_STATUS_QUEUE_SIZE];
+} Rte_RightDoorStatusQueueType;
+
+extern Rte_RightDoorStatusQueueType Rte_rightDoorStatus;
+
+/**
+ * @brief The runnable of the LeftDoor component
+ * 
+ */
+extern void LeftDoor_Runnable(void);
+
+/**
+ * @brief The runnable of the RightDoor component
+ * 
+ */
+extern void RightDoor_Runnable(void);
+
+/**
+ * @brief The runnable of the DoorContact component
+ * 
+ */
+extern void DoorContact_Runnable(void);
+
+/**
+ * @brief The runnable of the ModeManager component
+ * 
+ */
+extern void ModeManager_Runnable(void);
+
+/**
+ * @brief The runnable of the ModeManager component
+ * 
+ */
+extern void ModeManager_SleepRunnable(void);
+
+/**
+ * @brief The runnable of the Dimmer component
+ * 
+ */
+extern void Dimmer_Runnable(void);
+
+/**
+ * @brief The runnable of the Lighting component
+ * 
+ */
+extern void Lighting_Runnable(void);
+
+/* The task periods of the description, a build may define others to run the same runnables slower or faster */
+#ifndef RTE_FAST_TASK_PERIOD_MS
+#define RTE_FAST_TASK_PERIOD_MS                 10
+#endif
+#ifndef RTE_SLOW_TASK_PERIOD_MS
+#define RTE_SLOW_TASK_PERIOD_MS                 100
+#endif
+
+extern const task_t Rte_fastTask;
+extern const task_t Rte_slowTask;
+
+#define RTE_EVENT_LEFT_DOOR_RUNNABLE            ((uint8_t)1 << 0)
+#define RTE_EVENT_RIGHT_DOOR_RUNNABLE           ((uint8_t)1 << 1)
+#define RTE_EVENT_DOOR_CONTACT_RUNNABLE         ((uint8_t)1 << 2)
+#define RTE_EVENT_MODE_MANAGER_RUNNABLE         ((uint8_t)1 << 3)
+#define RTE_EVENT_DIMMER_RUNNABLE               ((uint8_t)1 << 4)
+#define RTE_EVENT_LIGHTING_RUNNABLE             ((uint8_t)1 << 5)
+
+extern uint8_t Rte_fastEvents;
+
+extern uint8_t Rte_fastAlarms;
+extern uint32_t Rte_dimmerAlarm;
+
+/**
+ * @brief Runs Dimmer_Runnable once the scheduler time reaches a time, a new alarm replaces the set one
+ * 
+ * @param timeMs The time of Sched_GetTimeMs to run at
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_SetAlarm_Dimmer(uint32_t timeMs)
+{
+    Rte_dimmerAlarm = timeMs;
+    Rte_fastAlarms |= RTE_EVENT_DIMMER_RUNNABLE;
+    return E_OK;
+}
+
+/**
+ * @brief Cancels the alarm set by Rte_SetAlarm_Dimmer
+ * 
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_CancelAlarm_Dimmer(void)
+{
+    Rte_fastAlarms &= ~RTE_EVENT_DIMMER_RUNNABLE;
+    return E_OK;
+}
+
+/**
+ * @brief Runs LeftDoor_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_LeftDoor(void)
+{
+    Rte_fastEvents |= RTE_EVENT_LEFT_DOOR_RUNNABLE;
+}
+
+/**
+ * @brief Runs RightDoor_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_RightDoor(void)
+{
+    Rte_fastEvents |= RTE_EVENT_RIGHT_DOOR_RUNNABLE;
+}
+
+/**
+ * @brief Runs DoorContact_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_DoorContact(void)
+{
+    Rte_fastEvents |= RTE_EVENT_DOOR_CONTACT_RUNNABLE;
+}
+
+/**
+ * @brief Runs ModeManager_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_ModeManager(void)
+{
+    Rte_fastEvents |= RTE_EVENT_MODE_MANAGER_RUNNABLE;
+}
+
+/**
+ * @brief Runs Dimmer_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_Dimmer(void)
+{
+    Rte_fastEvents |= RTE_EVENT_DIMMER_RUNNABLE;
+}
+
+/**
+ * @brief Runs Lighting_Runnable again in the next activation of its task
+ * 
+ */
+static inline void Rte_Trigger_Lighting(void)
+{
+    Rte_fastEvents |= RTE_EVENT_LIGHTING_RUNNABLE;
+}
+
+/**
+ * @brief Called by Rte.c when the call of LeftDoorGetStatus returns, triggers its clients
+ * 
+ */
+static inline void Rte_Return_LeftDoorGetStatus(void)
+{
+#if defined(FIRST_CONTROLLER_APP)
+    Rte_fastEvents |= RTE_EVENT_LEFT_DOOR_RUNNABLE;
+#endif
+}
+
+/**
+ * @brief Called by Rte.c when the call of RightDoorGetStatus returns, triggers its clients
+ * 
+ */
+static inline void Rte_Return_RightDoorGetStatus(void)
+{
+#if defined(FIRST_CONTROLLER_APP)
+    Rte_fastEvents |= RTE_EVENT_RIGHT_DOOR_RUNNABLE;
+#endif
+}
+
+/**
+ * @brief Called by Rte.c when the call of LightingSetLevel returns, triggers its clients
+ * 
+ */
+static inline void Rte_Return_LightingSetLevel(void)
+{
+#if !defined(FIRST_CONTROLLER_APP)
+    Rte_fastEvents |= RTE_EVENT_LIGHTING_RUNNABLE;
+#endif
+}
+
+#define RTE_MODE_VEHICLE_MODE_RUN               0
+#define RTE_MODE_VEHICLE_MODE_ACCESSORY         1
+#define RTE_MODE_VEHICLE_MODE_SLEEP             2
+
+extern uint8_t Rte_vehicleMode;
+extern uint8_t Rte_vehicleModeMask;
+
+/**
+ * @brief Requests a switch of the vehicle mode, the scheduler applies it at its next tick
+ *
+ * @param mode The new mode
+ *              @arg RTE_MODE_VEHICLE_MODE_RUN
+ *              @arg RTE_MODE_VEHICLE_MODE_ACCESSORY
+ *              @arg RTE_MODE_VEHICLE_MODE_SLEEP
+ * @return Std_ReturnType
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_Switch_VehicleMode(uint8_t mode)
+{
+    return Sched_SwitchMode(mode);
+}
+
+/**
+ * @brief Gets the vehicle mode
+ * 
+ * @return uint8_t The current mode
+ */
+static inline uint8_t Rte_Mode_VehicleMode(void)
+{
+    return Rte_vehicleMode;
+}
+
+/**
+ * @brief Called by the scheduler after a mode switch
+ * 
+ */
+extern void Rte_ModeSwitched(void);
+
+typedef struct
+{
+    uint8_t doorContactStatus;
+    uint8_t dimmerStatus;
+} Rte_FastBufferType;
+
+extern Rte_FastBufferType Rte_fastBuffer;
+
+/**
+ * @brief Queues the door status in the RTE
+ * 
+ * @param status The status of the door
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
+ * @return Std_ReturnType 
+ *              E_OK If the value is queued
+ *              RTE_E_LIMIT If the queue is full, the value is not queued and is to be sent again
+ */
+static inline Std_ReturnType Rte_Send_LeftDoorStatus(uint8_t status)
+{
+    Std_ReturnType error = RTE_E_LIMIT;
+    uint8_t head = Rte_leftDoorStatus.head;
+    if((uint8_t)(head - Rte_leftDoorStatus.tail) < RTE_LEFT_DOOR_STATUS_QUEUE_SIZE)
+    {
+        TRACE(TRACE_EVENT_PORT_WRITE, RTE_TRACE_LEFT_DOOR_STATUS, (uint8_t)status);
+        Rte_leftDoorStatus.data[head & (RTE_LEFT_DOOR_STATUS_QUEUE_SIZE - 1)] = status;
+        Rte_leftDoorStatus.head = head + 1;
+        error = E_OK;
+#if defined(FIRST_CONTROLLER_APP)
+        Rte_fastEvents |= RTE_EVENT_DOOR_CONTACT_RUNNABLE;
+#endif
+    }
+    return error;
+}
+
+/**
+ * @brief Takes the oldest the door status queued in the RTE
+ * 
+ * @param status The status of the door
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
+ * @return Std_ReturnType 
+ *              E_OK If a value is returned
+ *              RTE_E_NO_DATA If the queue is empty
+ */
+static inline Std_ReturnType Rte_Receive_LeftDoorStatus(uint8_t* status)
+{
+    Std_ReturnType error = RTE_E_NO_DATA;
+    uint8_t tail = Rte_leftDoorStatus.tail;
+    if(tail != Rte_leftDoorStatus.head)
+    {
+        *status = Rte_leftDoorStatus.data[tail & (RTE_LEFT_DOOR_STATUS_QUEUE_SIZE - 1)];
+        Rte_leftDoorStatus.tail = tail + 1;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Queues the door status in the RTE
+ * 
+ * @param status The status of the door
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
+ * @return Std_ReturnType 
+ *              E_OK If the value is queued
+ *              RTE_E_LIMIT If the queue is full, the value is not queued and is to be sent again
+ */
+static inline Std_ReturnType Rte_Send_RightDoorStatus(uint8_t status)
+{
+    Std_ReturnType error = RTE_E_LIMIT;
+    uint8_t head = Rte_rightDoorStatus.head;
+    if((uint8_t)(head - Rte_rightDoorStatus.tail) < RTE_RIGHT_DOOR_STATUS_QUEUE_SIZE)
+    {
+        TRACE(TRACE_EVENT_PORT_WRITE, RTE_TRACE_RIGHT_DOOR_STATUS, (uint8_t)status);
+        Rte_rightDoorStatus.data[head & (RTE_RIGHT_DOOR_STATUS_QUEUE_SIZE - 1)] = status;
+        Rte_rightDoorStatus.head = head + 1;
+        error = E_OK;
+#if defined(FIRST_CONTROLLER_APP)
+        Rte_fastEvents |= RTE_EVENT_DOOR_CONTACT_RUNNABLE;
+#endif
+    }
+    return error;
+}
+
+/**
+ * @brief Takes the oldest the door status queued in the RTE
+ * 
+ * @param status The status of the door
+ *              @arg DOOR_CLOSED If the door is closed
+ *              @arg DOOR_OPEN If the door is open
+ * @return Std_ReturnType 
+ *              E_OK If a value is returned
+ *              RTE_E_NO_DATA If the queue is empty
+ */
+static inline Std_ReturnType Rte_Receive_RightDoorStatus(uint8_t* status)
+{
+    Std_ReturnType error = RTE_E_NO_DATA;
+    uint8_t tail = Rte_rightDoorStatus.tail;
+    if(tail != Rte_rightDoorStatus.head)
+    {
+        *status = Rte_rightDoorStatus.data[tail & (RTE_RIGHT_DOOR_STATUS_QUEUE_SIZE - 1)];
+        Rte_rightDoorStatus.tail = tail + 1;
+        error = E_OK;
+    }
+    return error;
+}
+
+/**
+ * @brief Writes the door contact status to the RTE
+ * 
+ * @param status The status of the doors
+ *              @arg DOOR_CLOSED If all the doors are closed
+ *              @arg DOOR_OPEN If a door is open
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_Write_DoorContactStatus(uint8_t status)
+{
+    uint8_t sreg = RTE_SREG;
+    uint8_t flags;
+    TRACE(TRACE_EVENT_PORT_WRITE, RTE_TRACE_DOOR_CONTACT_STATUS, (uint8_t)status);
+    /* The byte is shared with other ports so it is updated with the interrupts masked */
+    RTE_SREG = sreg & RTE_GLOBAL_INT_DIS;
+    flags = Rte_flags[0];
+    Rte_flags[0] = status ? (flags | RTE_FLAG_DOOR_CONTACT_STATUS) : (flags & ~RTE_FLAG_DOOR_CONTACT_STATUS);
+    RTE_SREG = sreg;
+    if(((flags & RTE_FLAG_DOOR_CONTACT_STATUS) != 0) != (status != 0))
+    {
+#if defined(FIRST_CONTROLLER_APP)
+        Rte_fastEvents |= RTE_EVENT_MODE_MANAGER_RUNNABLE;
+#endif
+#if !defined(FIRST_CONTROLLER_APP)
+        Rte_fastEvents |= RTE_EVENT_DIMMER_RUNNABLE;
+#endif
+    }
+    return E_OK;
+}
+
+/**
+ * @brief Reads the door contact status from the RTE
+ * 
+ * @param status The status of the doors
+ *              @arg DOOR_CLOSED If all the doors are closed
+ *              @arg DOOR_OPEN If a door is open
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_Read_DoorContactStatus(uint8_t* status)
+{
+    *status = (Rte_flags[0] & RTE_FLAG_DOOR_CONTACT_STATUS) != 0;
+    return E_OK;
+}
+
+/**
+ * @brief Reads the door contact status copied to the task buffer before the runnable
+ * 
+ * @return uint8_t The status of the doors
+ */
+static inline uint8_t Rte_IRead_DoorContactStatus(void)
+{
+    return Rte_fastBuffer.doorContactStatus;
+}
+
+/**
+ * @brief Writes the dimmer status to the RTE
+ * 
+ * @param status The status of the dimmer
+ *              @arg DIMMER_ON If the dimmer is on
+ *              @arg DIMMER_OFF If the dimmer is off
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_Write_DimmerStatus(uint8_t status)
+{
+    uint8_t sreg = RTE_SREG;
+    uint8_t flags;
+    TRACE(TRACE_EVENT_PORT_WRITE, RTE_TRACE_DIMMER_STATUS, (uint8_t)status);
+    /* The byte is shared with other ports so it is updated with the interrupts masked */
+    RTE_SREG = sreg & RTE_GLOBAL_INT_DIS;
+    flags = Rte_flags[0];
+    Rte_flags[0] = status ? (flags | RTE_FLAG_DIMMER_STATUS) : (flags & ~RTE_FLAG_DIMMER_STATUS);
+    RTE_SREG = sreg;
+    if(((flags & RTE_FLAG_DIMMER_STATUS) != 0) != (status != 0))
+    {
+#if !defined(FIRST_CONTROLLER_APP)
+        Rte_fastEvents |= RTE_EVENT_LIGHTING_RUNNABLE;
+#endif
+    }
+    return E_OK;
+}
+
+/**
+ * @brief Reads the dimmer status from the RTE
+ * 
+ * @param status The status of the dimmer
+ *              @arg DIMMER_ON If the dimmer is on
+ *              @arg DIMMER_OFF If the dimmer is off
+ * @return Std_ReturnType 
+ *              E_OK If the function executed successfully
+ *              E_NOT_OK If the function did not execute successfully
+ */
+static inline Std_ReturnType Rte_Read_DimmerStatus(uint8_t* status)
+{
+    *status = (Rte_flags[0] & RTE_FLAG_DIMMER_STATUS) != 0;
+    return E_OK;
+}
+
+/**
+ * @brief Writes the dimmer status to the task buffer, the RTE publishes it after the runnable
+ * 
+ * @param status The status of the dimmer
+ *              @arg DIMMER_ON If the dimmer is on
+ *              @arg DIMMER_OFF If the dimmer is off
+ */
+static inline void Rte_IWrite_DimmerStatus(uint8_t status)
+{
+    Rte_fastBuffer.dimmerStatus = status;
+}
+
+/**
+ * @brief Reads the dimmer status copied to the task buffer before the runnable
+ * 
+ * @return uint8_t The status of the dimmer
+ */
+static inline uint8_t Rte_IRead_DimmerStatus(void)
+{
+    return Rte_fastBuffer.dimmerStatus;
+}
+
+#endif
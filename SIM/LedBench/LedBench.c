@@ -0,0 +1,305 @@
+/**
+ * @file LedBench.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the benchmark of the Led PWM of the host simulation
+ *        build.sh builds Led.c, Timer2.c and Gpio.c with LED_BENCH_LEDS Leds into one program per number of Leds
+ *        It plays Timer2 on the register file, one overflow then a compare match at every OCR2 until the one at 255,
+ *        and runs the Led task every LED_TASK_PERIOD_MS of the simulated time
+ *        For the Leds at distinct levels, at one shared level, all on, all off and fading from off to distinct levels
+ *        it prints
+ *          - the compare interrupts of a period, the match at 255 included
+ *          - the writes to the Led ports of a period, Gpio_WritePortMasked is wrapped by the linker to count them
+ *          - the host time of the interrupts of a period and of the task building a schedule
+ *        The host time only compares the numbers of Leds with each other, it is not the time of the ATMEGA32
+ *        It checks in steady state that every Led turns on at the overflow and off at the compare match of its duty
+ *        and exits with 1 when one does not
+ * @version 0.1
+ * @date 2020-05-02
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Reg_Access.h"
+#include "Gpio.h"
+#include "Sched.h"
+#include "Led.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_OCR2                  REG8(0x43)
+#define BENCH_TCNT2                 REG8(0x44)
+/* The PORT register of a port is two above its PIN register */
+#define BENCH_PORT(port)            REG8((port) + 2)
+#define BENCH_DUTY_FULL             255
+
+/* The periods timed in steady state */
+#define BENCH_PERIODS               200000
+/* The fades timed and their time */
+#define BENCH_FADES                 200
+#define BENCH_FADE_MS               500
+/* The levels of the Leds at distinct levels go from BENCH_LOW_LEVEL where the gamma table gives
+   one duty per level, the shared level is the middle of the range */
+#define BENCH_LOW_LEVEL             20
+#define BENCH_HIGH_LEVEL            95
+#define BENCH_SHARED_LEVEL          50
+
+typedef struct
+{
+  unsigned long compares;
+  double writes;
+  double isrNs;
+  double taskNs;
+} benchResult_t;
+
+volatile uint8_t Sim_registers[REG_FILE_SIZE];
+
+extern const led_t Led_leds[LED_NUMBER_OF_LEDS];
+extern const uint8_t Led_gamma[LED_LEVEL_MAX + 1];
+extern const task_t Led_task;
+
+void __vector_4(void);
+void __vector_5(void);
+
+static int Bench_taskActive;
+static int Bench_failed;
+static unsigned long Bench_compares;
+static unsigned long Bench_writes;
+static double Bench_isrNs;
+static double Bench_taskNs;
+static unsigned long Bench_builds;
+
+/* The scheduler of the benchmark, the Led task is the only one */
+Std_ReturnType Sched_SuspendTask(void)
+{
+  Bench_taskActive = 0;
+  return E_OK;
+}
+
+Std_ReturnType Sched_ActivateTask(const task_t* task)
+{
+  Bench_taskActive = (task == &Led_task) ? 1 : Bench_taskActive;
+  return (task == &Led_task) ? E_OK : E_NOT_OK;
+}
+
+Std_ReturnType __real_Gpio_WritePortMasked(uint8_t port, uint8_t mask, uint8_t value);
+
+Std_ReturnType __wrap_Gpio_WritePortMasked(uint8_t port, uint8_t mask, uint8_t value)
+{
+  Bench_writes++;
+  return __real_Gpio_WritePortMasked(port, mask, value);
+}
+
+static double Bench_Now(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * @brief Checks the pins of the Leds at a count of Timer2 against the duties of their levels
+ *
+ * @param levels The levels of the Leds
+ * @param count The count, the Leds with a duty above it are on
+ */
+static void Bench_Check(const uint8_t* levels, int count)
+{
+  int i;
+  int on;
+  int expected;
+  for(i = 0; i < LED_NUMBER_OF_LEDS; i++)
+  {
+    on = (BENCH_PORT(Led_leds[i].port) & Led_leds[i].pin) != 0;
+    expected = Led_gamma[levels[i]] == BENCH_DUTY_FULL || Led_gamma[levels[i]] > count;
+    if(on != expected && !Bench_failed)
+    {
+      printf("FAIL: Led %d at level %d is %s at count %d\n", i, levels[i], on ? "on" : "off", count);
+      Bench_failed = 1;
+    }
+  }
+}
+
+/**
+ * @brief Plays a period of Timer2, the overflow then the compare matches up to the one at 255
+ *
+ * @param levels The levels to check the pins against, NULL to not check them
+ */
+static void Bench_Period(const uint8_t* levels)
+{
+  int count;
+  double start = Bench_Now();
+  BENCH_TCNT2 = 0;
+  __vector_5();
+  if(levels)
+  {
+    Bench_Check(levels, 0);
+  }
+  do
+  {
+    count = BENCH_OCR2;
+    BENCH_TCNT2 = count;
+    __vector_4();
+    Bench_compares++;
+    if(levels)
+    {
+      Bench_Check(levels, count);
+    }
+  } while(count != BENCH_DUTY_FULL);
+  Bench_isrNs += Bench_Now() - start;
+}
+
+/**
+ * @brief Runs the Led task once if it is active
+ *
+ */
+static void Bench_Task(void)
+{
+  double start;
+  if(Bench_taskActive)
+  {
+    start = Bench_Now();
+    Led_task.runnable();
+    Bench_taskNs += Bench_Now() - start;
+    Bench_builds++;
+  }
+}
+
+static void Bench_Reset(void)
+{
+  Bench_compares = 0;
+  Bench_writes = 0;
+  Bench_isrNs = 0;
+  Bench_taskNs = 0;
+  Bench_builds = 0;
+}
+
+/**
+ * @brief Sets the levels of the Leds at once and plays periods until the task built them
+ *
+ * @param levels The levels
+ */
+static void Bench_Settle(const uint8_t* levels)
+{
+  int i;
+  for(i = 0; i < LED_NUMBER_OF_LEDS; i++)
+  {
+    Led_SetLedLevel(i, levels[i], 0);
+  }
+  while(Bench_taskActive)
+  {
+    Bench_Task();
+    Bench_Period(NULL);
+  }
+  Bench_Period(NULL);
+}
+
+/**
+ * @brief Times the periods of the Leds at steady levels
+ *
+ * @param levels The levels
+ * @param result Save the result in
+ */
+static void Bench_Steady(const uint8_t* levels, benchResult_t* result)
+{
+  long i;
+  Bench_Settle(levels);
+  Bench_Reset();
+  Bench_Period(levels);
+  for(i = 1; i < BENCH_PERIODS; i++)
+  {
+    Bench_Period(NULL);
+  }
+  Bench_Period(levels);
+  result->compares = Bench_compares / (BENCH_PERIODS + 1);
+  result->writes = (double)Bench_writes / (BENCH_PERIODS + 1);
+  result->isrNs = Bench_isrNs / (BENCH_PERIODS + 1);
+  result->taskNs = 0;
+}
+
+/**
+ * @brief Times the fades of the Leds from off to their levels, the task runs every LED_TASK_PERIOD_MS
+ *        of the simulated time between the periods of the PWM
+ *
+ * @param levels The levels
+ * @param result Save the result in
+ */
+static void Bench_Fade(const uint8_t* levels, benchResult_t* result)
+{
+  static const uint8_t off[LED_NUMBER_OF_LEDS];
+  unsigned long periods = 0;
+  unsigned long timeUs;
+  unsigned long taskUs;
+  int fade;
+  int i;
+  Bench_Reset();
+  for(fade = 0; fade < BENCH_FADES; fade++)
+  {
+    Bench_Settle(off);
+    for(i = 0; i < LED_NUMBER_OF_LEDS; i++)
+    {
+      Led_SetLedLevel(i, levels[i], BENCH_FADE_MS);
+    }
+    timeUs = 0;
+    taskUs = 0;
+    while(Bench_taskActive)
+    {
+      if(taskUs <= timeUs)
+      {
+        Bench_Task();
+        taskUs += LED_TASK_PERIOD_MS * 1000UL;
+      }
+      else
+      {
+        Bench_Period(NULL);
+        periods++;
+        timeUs += LED_PWM_PERIOD_US;
+      }
+    }
+  }
+  result->compares = Bench_compares / periods;
+  result->writes = (double)Bench_writes / periods;
+  result->isrNs = Bench_isrNs / periods;
+  result->taskNs = Bench_taskNs / Bench_builds;
+}
+
+static void Bench_Print(const char* name, const benchResult_t* result)
+{
+  printf("%2d Leds  %-8s %2lu compares %5.1f writes %7.1f ns/period", LED_NUMBER_OF_LEDS, name, result->compares,
+         result->writes, result->isrNs);
+  if(result->taskNs)
+  {
+    printf(" %7.1f ns/task", result->taskNs);
+  }
+  printf("\n");
+}
+
+int main(void)
+{
+  uint8_t distinct[LED_NUMBER_OF_LEDS];
+  uint8_t shared[LED_NUMBER_OF_LEDS];
+  uint8_t on[LED_NUMBER_OF_LEDS];
+  uint8_t off[LED_NUMBER_OF_LEDS];
+  benchResult_t result;
+  int i;
+  Led_Init();
+  for(i = 0; i < LED_NUMBER_OF_LEDS; i++)
+  {
+    distinct[i] = BENCH_LOW_LEVEL + i * (BENCH_HIGH_LEVEL - BENCH_LOW_LEVEL) / LED_NUMBER_OF_LEDS;
+    shared[i] = BENCH_SHARED_LEVEL;
+    on[i] = LED_LEVEL_MAX;
+    off[i] = 0;
+  }
+  Bench_Steady(distinct, &result);
+  Bench_Print("distinct", &result);
+  Bench_Steady(shared, &result);
+  Bench_Print("shared", &result);
+  Bench_Steady(on, &result);
+  Bench_Print("on", &result);
+  Bench_Steady(off, &result);
+  Bench_Print("off", &result);
+  Bench_Fade(distinct, &result);
+  Bench_Print("fading", &result);
+  return Bench_failed;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file  Led_Cfg.c
+ * @brief This is the configuration of the Led benchmark of the host simulation
+ *        The Leds are spread over PORTA then PORTC, active high, with the gamma table of the dimmer
+ *
+ * @author Mark Attia
+ * @date May 2, 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Gpio.h"
+#include "Led.h"
+
+/* The gamma table of the dimmer, its single Led is renamed out of the way */
+#define Led_leds                        Led_dimmerLeds
+#include "../../BSW/Complex Drivers/Led/Led_Cfg.c"
+#undef Led_leds
+
+#define LED_BENCH_LED(i)                {(uint8_t)(GPIO_PIN_0 << ((i) % 8)), ((i) < 8) ? GPIO_PORTA : GPIO_PORTC, \
+                                         GPIO_PIN_SET}
+
+#if LED_NUMBER_OF_LEDS != 1 && LED_NUMBER_OF_LEDS != 2 && LED_NUMBER_OF_LEDS != 4 && \
+    LED_NUMBER_OF_LEDS != 8 && LED_NUMBER_OF_LEDS != 16
+#error "LED_BENCH_LEDS must be 1, 2, 4, 8 or 16"
+#endif
+
+const led_t Led_leds[LED_NUMBER_OF_LEDS] = {
+    LED_BENCH_LED(0),
+#if LED_NUMBER_OF_LEDS > 1
+    LED_BENCH_LED(1),
+#endif
+#if LED_NUMBER_OF_LEDS > 2
+    LED_BENCH_LED(2), LED_BENCH_LED(3),
+#endif
+#if LED_NUMBER_OF_LEDS > 4
+    LED_BENCH_LED(4), LED_BENCH_LED(5), LED_BENCH_LED(6), LED_BENCH_LED(7),
+#endif
+#if LED_NUMBER_OF_LEDS > 8
+    LED_BENCH_LED(8), LED_BENCH_LED(9), LED_BENCH_LED(10), LED_BENCH_LED(11),
+    LED_BENCH_LED(12), LED_BENCH_LED(13), LED_BENCH_LED(14), LED_BENCH_LED(15),
+#endif
+};
@@ -0,0 +1,27 @@
+/**
+ * @file  Led_Cfg.h
+ * @brief This is the configuration of the Led benchmark of the host simulation
+ *        build.sh builds Led.c against it with LED_BENCH_LEDS Leds, the rest matches the dimmer
+ *
+ * @author Mark Attia
+ * @date May 2, 2020
+ *
+ */
+#ifndef LED_CFG_H
+#define LED_CFG_H
+
+#ifndef LED_BENCH_LEDS
+#define LED_BENCH_LEDS                  16
+#endif
+
+#define LED_NUMBER_OF_LEDS              LED_BENCH_LEDS
+
+#define DIMMER_LAMP                     0
+
+#define LED_PWM_PRESCALER               TMR2_DIV_256
+#define LED_PWM_PERIOD_US               8192
+
+#define LED_TASK_PERIOD_MS              10
+
+
+#endif
@@ -0,0 +1,1173 @@
+/**
+ * @file Sim.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the host simulation of the door and the dimmer ECUs
+ *        It loads the two images built by build.sh, each one with its own register file and globals,
+ *        runs them in lockstep on one clock and carries the bytes of their UARTs over a virtual wire
+ *        that takes the frame time of every byte, adds a propagation delay and can inject errors
+ *        It runs one of the scenarios
+ *          latency : The door is opened at a random phase of the ticks and the time until the dimmer sets
+ *                    the lamp for the same sequence tag is measured, then the door is closed and the lamp
+ *                    left to go off. It prints the percentiles and a histogram of the latency with the errors
+ *                    seen on the link and fails if a door opening never reached the lamp
+ *          debounce : The door contact bounces on every opening and closing and glitches shorter than the
+ *                     debounce time while it is closed. It fails if a bounced change gives other than one
+ *                     edge, if a glitch gives an edge or if the switch task runs while the switches are
+ *                     idle with SWITCH_DETECTION_INTERRUPT
+ *          mode : The doors stay closed until the door ECU sleeps, then a door is opened. It fails if the
+ *                 dimmer does not sleep after the door ECU, if a byte is sent or a dimmer runnable runs
+ *                 while they sleep or if the opening does not wake the dimmer and reach the lamp
+ *          dimmer : A door is opened and closed, then opened for longer than the battery saver. It fails if the
+ *                   lamp does not go off on time after the close delay and after the battery saver, counted from
+ *                   the run of the dimmer that saw the door, or if the dimmer runs other than once per door
+ *                   change and timeout. Build with SCHED_START_TIME_MS near the wrap and another
+ *                   RTE_FAST_TASK_PERIOD_MS to check the timeouts across the wrap and at other task periods
+ *          tp : Needs both images built with UART_LINK_TP. The door sends messages through the Transport Protocol
+ *               and the dimmer puts them in a sink, which can be drained slower than the line so the dimmer
+ *               makes the door wait. It prints the percentiles of the transfer time and the throughput and fails
+ *               if a message is not received whole and right on a clean link, if the door confirms a message
+ *               before its last byte left the UART or if a message does not end on both ECUs. The frames have
+ *               no checksum, so with errors on the wire a wrong byte is counted but is not a failure
+ *        It exits with 1 when a scenario fails
+ * @version 0.1
+ * @date 2020-05-02
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SimEcu.h"
+
+#define SIM_DOOR                    0
+#define SIM_DIMMER                  1
+#define SIM_NUMBER_OF_ECUS          2
+
+/* The trace events of Trace.h the scenarios use */
+#define SIM_TASK_START              1
+#define SIM_RUNNABLE_START          3
+#define SIM_SEQUENCE_START          6
+#define SIM_SEQUENCE_END            7
+#define SIM_MODE_SWITCH             8
+#define SIM_NUMBER_OF_EVENTS        9
+#define SIM_ANY                     (-1)
+/* The width of DOOR_SEQUENCE_SIGNAL, the dimmer only sees these bits of the tag */
+#define SIM_TAG_MASK                0x7F
+/* The trace id of Dimmer_Runnable in RTE/Rte_Gen.h */
+#define SIM_DIMMER_RUNNABLE         5
+/* The trace id of Rte_serverTask, its index in Sched_Cfg.c, it runs every tick of SCHED_TICK_TIME_MS */
+#define SIM_SERVER_TASK             3
+#define SIM_TICK_MS                 5
+/* The vehicle modes of RTE/Rte_Description.json */
+#define SIM_MODE_RUN                0
+#define SIM_MODE_SLEEP              2
+
+#define SIM_US(us)                  ((simTime_t)(us) * SIM_ECU_CYCLES_PER_US)
+#define SIM_MS(ms)                  SIM_US((simTime_t)(ms) * 1000)
+
+/* A door is closed when its switch pulls the pin low */
+#define SIM_DOOR_CLOSED             0x00
+#define SIM_DOOR_OPEN               0xFF
+
+/* The lamp goes off DIMMER_CLOSE_DELAY_MS after the doors are closed, the doors read open until
+   the first debounce so the lamp also goes on at start up */
+#define SIM_CLOSED_MS               11000
+/* The time a door stays open */
+#define SIM_HOLD_MS                 200
+/* A door opening that has not reached the lamp after this time is counted as lost */
+#define SIM_TIMEOUT_MS              2000
+/* The time the switch task is watched while the switches are idle */
+#define SIM_IDLE_MS                 1000
+/* The door ECU sleeps MODE_MANAGER_SLEEP_DELAY_MS after the doors are closed */
+#define SIM_SLEEP_MS                31000
+/* The close delay and the battery saver of Dimmer.c */
+#define SIM_DELAY_MS                10000
+#define SIM_SAVER_MS                600000
+/* A timeout of the dimmer may reach the lamp this late, two activations of a 20 ms task and a server tick */
+#define SIM_LATE_MS                 50
+/* A tick of SIM_TICK_MS takes a whole number of Timer0 counts, 5.024 ms, the waits for the timeouts allow 1 % more */
+#define SIM_TICKS_MS(ms)            ((ms) + (ms) / 100)
+/* The dimmer scenario changes the door four times and times out twice */
+#define SIM_DIMMER_RUNS             6
+/* The bounces of the debounce scenario if none are given */
+#define SIM_DEFAULT_BOUNCES         5
+/* The openings are spread over this window, a multiple of every task period */
+#define SIM_PHASE_WINDOW_US         20000
+
+/* The time for both images to initialise the Transport Protocol */
+#define SIM_TP_START_MS             100
+/* A message that has not ended on both ECUs after this time is stuck */
+#define SIM_TP_TIMEOUT_MS           120000
+/* The frame of TP_FRAME_SIZE, the dimmer only sends flow controls in the tp scenario */
+#define SIM_TP_FRAME_SIZE           8
+
+#define SIM_WIRE_SIZE               256
+#define SIM_HISTOGRAM_BARS          50
+
+typedef struct
+{
+  unsigned char byte;
+  unsigned char errors;
+  unsigned char format;
+  simTime_t time;             /* The end of the stop bits at the receiver */
+  simTime_t frameCycles;
+} simByte_t;
+
+typedef struct
+{
+  simByte_t byte[SIM_WIRE_SIZE];
+  unsigned int head;
+  unsigned int count;
+  unsigned long sent;
+  unsigned long dropped;
+  unsigned long bitErrors;
+  unsigned long framingErrors;
+} simWire_t;
+
+typedef struct
+{
+  const simEcu_t* ecu;
+  simTime_t origin;
+  simWire_t wire;             /* The bytes on their way to the other ECU */
+} simNode_t;
+
+typedef struct
+{
+  const char* image[SIM_NUMBER_OF_ECUS];
+  unsigned long baud[SIM_NUMBER_OF_ECUS];
+  unsigned long runs;
+  unsigned long long seed;
+  unsigned long delayUs;
+  unsigned long phaseUs;
+  unsigned long bucketUs;
+  unsigned long bounces;
+  unsigned long bounceUs;
+  unsigned long glitchUs;
+  unsigned char switchName;
+  unsigned long tpLength;
+  unsigned long sinkRate;
+  unsigned long sinkSize;
+  const char* scenario;
+  double bitErrorRate;
+  double framingErrorRate;
+  double dropRate;
+} simOptions_t;
+
+/* A trace record a scenario waits for */
+typedef struct
+{
+  int ecu;
+  unsigned char event;
+  int id;                     /* SIM_ANY for any id */
+  int data;                   /* SIM_ANY for any data */
+  unsigned char mask;         /* The bits of the data compared */
+  int found;
+  simTime_t time;
+  unsigned char value;        /* The data of the record found */
+} simWait_t;
+
+typedef struct
+{
+  unsigned long samples;
+  unsigned long timeouts;
+  simTime_t* latency;
+  simTime_t* debounce;
+} simLatency_t;
+
+static simNode_t Sim_node[SIM_NUMBER_OF_ECUS];
+static simOptions_t Sim_options;
+static unsigned long long Sim_random;
+static simTime_t Sim_now;
+static int Sim_started[SIM_NUMBER_OF_ECUS];
+/* The records seen of every event and id on every ECU */
+static unsigned long Sim_count[SIM_NUMBER_OF_ECUS][SIM_NUMBER_OF_EVENTS][256];
+static simWait_t* Sim_wait;
+static unsigned char Sim_port;
+static unsigned char Sim_pin;
+
+/**
+ * @brief Gets the next number of the xorshift generator
+ *
+ * @return double A number from 0 up to 1
+ */
+static double Sim_Random(void)
+{
+  Sim_random ^= Sim_random >> 12;
+  Sim_random ^= Sim_random << 25;
+  Sim_random ^= Sim_random >> 27;
+  return (double)((Sim_random * 2685821657736338717ULL) >> 11) / (double)(1ULL << 53);
+}
+
+/**
+ * @brief Puts a byte an ECU sends on the wire to the other ECU
+ *        The bits are flipped at the bit error rate, a flipped start or stop bit is a framing error
+ *        and an odd number of flipped data and parity bits is a parity error if the frame has parity
+ *
+ * @param context The node of the sender
+ * @param byte The byte
+ * @param start The time of the start bit
+ * @param frameCycles The time of the frame
+ * @param format The UCSRC of the sender
+ */
+static void Sim_Transmit(void* context, unsigned char byte, simTime_t start, simTime_t frameCycles,
+                         unsigned char format)
+{
+  simWire_t* wire = &((simNode_t*)context)->wire;
+  simByte_t* slot;
+  unsigned int bits = 10 + ((format & 0x30) ? 1 : 0) + ((format & 0x08) ? 1 : 0);
+  unsigned int bit;
+  unsigned int flips = 0;
+  unsigned char errors = 0;
+  wire->sent++;
+  if (Sim_Random() < Sim_options.dropRate || wire->count == SIM_WIRE_SIZE)
+  {
+    wire->dropped++;
+    return;
+  }
+  for (bit = 0; bit < bits; bit++)
+  {
+    if (Sim_options.bitErrorRate > 0 && Sim_Random() < Sim_options.bitErrorRate)
+    {
+      wire->bitErrors++;
+      if (bit >= 1 && bit <= 8)
+      {
+        byte ^= (unsigned char)(1 << (bit - 1));
+        flips++;
+      }
+      else if (bit == 9 && (format & 0x30))
+      {
+        flips++;
+      }
+      else
+      {
+        errors |= SIM_ECU_FRAMING_ERROR;
+      }
+    }
+  }
+  if ((format & 0x30) && (flips & 1))
+  {
+    errors |= SIM_ECU_PARITY_ERROR;
+  }
+  if (Sim_options.framingErrorRate > 0 && Sim_Random() < Sim_options.framingErrorRate)
+  {
+    errors |= SIM_ECU_FRAMING_ERROR;
+  }
+  if (errors & SIM_ECU_FRAMING_ERROR)
+  {
+    wire->framingErrors++;
+  }
+  slot = &wire->byte[(wire->head + wire->count) % SIM_WIRE_SIZE];
+  slot->byte = byte;
+  slot->errors = errors;
+  slot->format = format;
+  slot->frameCycles = frameCycles;
+  slot->time = start + frameCycles + SIM_US(Sim_options.delayUs);
+  wire->count++;
+}
+
+/**
+ * @brief Loads an ECU image
+ *
+ * @param path The shared object of the image
+ * @return const simEcu_t* The interface of the image, NULL if it cannot be loaded
+ */
+static const simEcu_t* Sim_Load(const char* path)
+{
+  const simEcu_t* ecu = NULL;
+  /* Every image keeps its own symbols so both can have the same globals */
+  void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (handle)
+  {
+    ecu = (const simEcu_t*)dlsym(handle, SIM_ECU_INTERFACE);
+  }
+  if (!ecu)
+  {
+    fprintf(stderr, "sim: cannot load %s: %s\n", path, dlerror());
+  }
+  return ecu;
+}
+
+/**
+ * @brief Converts the time of a trace record to the simulated time
+ *        The 32 bit micro seconds of the record are taken as the last ones before the current time
+ *
+ * @param node The node of the record
+ * @param now The current time
+ * @param timeUs The time of the record
+ * @return simTime_t The simulated time
+ */
+static simTime_t Sim_TraceTime(const simNode_t* node, simTime_t now, unsigned long timeUs)
+{
+  unsigned long nowUs = (unsigned long)((now - node->origin) / SIM_ECU_CYCLES_PER_US);
+  return now - SIM_US((nowUs - timeUs) & 0xFFFFFFFFUL);
+}
+
+/**
+ * @brief Counts a trace record and checks it against the record waited for
+ *
+ * @param ecu The ECU of the record
+ * @param record The record
+ */
+static void Sim_Record(int ecu, const simTrace_t* record)
+{
+  simWait_t* wait = Sim_wait;
+  if (record->event < SIM_NUMBER_OF_EVENTS)
+  {
+    Sim_count[ecu][record->event][record->id]++;
+  }
+  if (wait && !wait->found && wait->ecu == ecu && wait->event == record->event &&
+      (wait->id == SIM_ANY || wait->id == record->id) &&
+      (wait->data == SIM_ANY || ((wait->data ^ record->data) & wait->mask) == 0))
+  {
+    wait->found = 1;
+    wait->time = Sim_TraceTime(&Sim_node[ecu], Sim_now, record->timeUs);
+    wait->value = record->data;
+  }
+}
+
+/**
+ * @brief Runs both ECUs and the wire to the next thing that happens, not after a time
+ *
+ * @param until The time
+ */
+static void Sim_Step(simTime_t until)
+{
+  simTime_t next = until;
+  simTime_t time;
+  simByte_t* byte;
+  simTrace_t record;
+  int itr;
+  for (itr = 0; itr < SIM_NUMBER_OF_ECUS; itr++)
+  {
+    time = Sim_started[itr] ? Sim_node[itr].ecu->nextEvent() : Sim_node[itr].origin;
+    next = (time < next) ? time : next;
+    if (Sim_node[itr].wire.count)
+    {
+      time = Sim_node[itr].wire.byte[Sim_node[itr].wire.head].time;
+      next = (time < next) ? time : next;
+    }
+  }
+  Sim_now = next;
+  for (itr = 0; itr < SIM_NUMBER_OF_ECUS; itr++)
+  {
+    if (Sim_started[itr])
+    {
+      Sim_node[itr].ecu->run(Sim_now);
+    }
+    else if (Sim_now == Sim_node[itr].origin)
+    {
+      Sim_node[itr].ecu->start(Sim_now);
+      Sim_started[itr] = 1;
+    }
+  }
+  for (itr = 0; itr < SIM_NUMBER_OF_ECUS; itr++)
+  {
+    while (Sim_node[itr].wire.count && Sim_node[itr].wire.byte[Sim_node[itr].wire.head].time <= Sim_now)
+    {
+      byte = &Sim_node[itr].wire.byte[Sim_node[itr].wire.head];
+      if (Sim_started[1 - itr])
+      {
+        Sim_node[1 - itr].ecu->receive(byte->byte, byte->errors, byte->frameCycles, byte->format);
+      }
+      Sim_node[itr].wire.head = (Sim_node[itr].wire.head + 1) % SIM_WIRE_SIZE;
+      Sim_node[itr].wire.count--;
+    }
+  }
+  for (itr = 0; itr < SIM_NUMBER_OF_ECUS; itr++)
+  {
+    while (Sim_node[itr].ecu->readTrace(&record))
+    {
+      Sim_Record(itr, &record);
+    }
+  }
+}
+
+/**
+ * @brief Runs the simulation up to a time or until a trace record is seen
+ *
+ * @param until The time
+ * @param wait The record to stop at, NULL to run up to the time
+ * @return int 1 if the record was seen
+ */
+static int Sim_Run(simTime_t until, simWait_t* wait)
+{
+  Sim_wait = wait;
+  while (Sim_now < until && !(wait && wait->found))
+  {
+    Sim_Step(until);
+  }
+  Sim_wait = NULL;
+  return wait && wait->found;
+}
+
+/**
+ * @brief Waits for a random phase of the ticks
+ *
+ */
+static void Sim_Phase(void)
+{
+  Sim_Run(Sim_now + SIM_US(Sim_Random() * SIM_PHASE_WINDOW_US), NULL);
+}
+
+/**
+ * @brief Moves the door, bouncing if bounces are given
+ *
+ * @param levels SIM_DOOR_OPEN or SIM_DOOR_CLOSED
+ * @param bounces The number of bounces
+ */
+static void Sim_MoveDoor(unsigned char levels, unsigned long bounces)
+{
+  if (bounces)
+  {
+    Sim_node[SIM_DOOR].ecu->bounce(Sim_port, Sim_pin, levels, (unsigned int)bounces, Sim_options.bounceUs);
+  }
+  else
+  {
+    Sim_node[SIM_DOOR].ecu->drive(Sim_port, Sim_pin, levels);
+  }
+}
+
+/**
+ * @brief Compares two times for qsort
+ *
+ * @param first The first time
+ * @param second The second time
+ * @return int The order
+ */
+static int Sim_Compare(const void* first, const void* second)
+{
+  simTime_t a = *(const simTime_t*)first;
+  simTime_t b = *(const simTime_t*)second;
+  return (a > b) - (a < b);
+}
+
+/**
+ * @brief Prints the percentiles of some times
+ *
+ * @param name The name of the times
+ * @param times The times, they are sorted
+ * @param count The number of times
+ */
+static void Sim_PrintPercentiles(const char* name, simTime_t* times, unsigned long count)
+{
+  unsigned long itr;
+  double sum = 0;
+  qsort(times, count, sizeof(simTime_t), Sim_Compare);
+  for (itr = 0; itr < count; itr++)
+  {
+    sum += (double)times[itr];
+  }
+  printf("%-12s p50 %8.3f ms  p99 %8.3f ms  max %8.3f ms  mean %8.3f ms\n", name,
+         (double)times[(count - 1) / 2] / SIM_MS(1), (double)times[(count * 99 + 99) / 100 - 1] / SIM_MS(1),
+         (double)times[count - 1] / SIM_MS(1), sum / count / SIM_MS(1));
+}
+
+/**
+ * @brief Prints the histogram of the sorted latencies
+ *
+ * @param scenario The latencies
+ */
+static void Sim_PrintHistogram(const simLatency_t* scenario)
+{
+  simTime_t bucket = SIM_US(Sim_options.bucketUs);
+  simTime_t first = scenario->latency[0] / bucket;
+  unsigned long buckets = (unsigned long)(scenario->latency[scenario->samples - 1] / bucket - first) + 1;
+  unsigned long* count = calloc(buckets, sizeof(unsigned long));
+  unsigned long most = 1;
+  unsigned long itr;
+  unsigned long bar;
+  for (itr = 0; itr < scenario->samples; itr++)
+  {
+    count[scenario->latency[itr] / bucket - first]++;
+  }
+  for (itr = 0; itr < buckets; itr++)
+  {
+    most = (count[itr] > most) ? count[itr] : most;
+  }
+  for (itr = 0; itr < buckets; itr++)
+  {
+    printf("%8.3f ms %6lu ", (double)((first + itr) * bucket) / SIM_MS(1), count[itr]);
+    for (bar = 0; bar < count[itr] * SIM_HISTOGRAM_BARS / most; bar++)
+    {
+      putchar('#');
+    }
+    putchar('\n');
+  }
+  free(count);
+}
+
+/**
+ * @brief Prints the counters of the wire and the UART of an ECU
+ *
+ * @param name The name of the ECU
+ * @param node The node of the ECU
+ */
+static void Sim_PrintLink(const char* name, const simNode_t* node)
+{
+  simUartStats_t stats;
+  node->ecu->getUartStats(&stats);
+  printf("%-7s wire: %lu sent, %lu dropped, %lu bit errors, %lu framing errors\n", name, node->wire.sent,
+         node->wire.dropped, node->wire.bitErrors, node->wire.framingErrors);
+  printf("%-7s uart: %lu tx, %lu rx, %lu overrun, %lu framing, %lu parity, %lu discarded, %lu trace lost\n", name,
+         stats.txBytes, stats.rxBytes, stats.overrunErrors, stats.framingErrors, stats.parityErrors,
+         stats.discardedFrames, node->ecu->getTraceLost());
+}
+
+/**
+ * @brief Measures the latency from a door opening to the lamp
+ *
+ * @return int 1 if every opening reached the lamp
+ */
+static int Sim_Latency(void)
+{
+  simLatency_t latency;
+  simWait_t start;
+  simWait_t end;
+  simTime_t openTime;
+  unsigned long run;
+  memset(&latency, 0, sizeof(latency));
+  latency.latency = calloc(Sim_options.runs, sizeof(simTime_t));
+  latency.debounce = calloc(Sim_options.runs, sizeof(simTime_t));
+  Sim_Run(SIM_MS(SIM_CLOSED_MS), NULL);
+  for (run = 0; run < Sim_options.runs; run++)
+  {
+    Sim_Phase();
+    Sim_MoveDoor(SIM_DOOR_OPEN, Sim_options.bounces);
+    openTime = Sim_now;
+    memset(&start, 0, sizeof(start));
+    start.ecu = SIM_DOOR;
+    start.event = SIM_SEQUENCE_START;
+    start.id = Sim_options.switchName;
+    start.data = SIM_ANY;
+    memset(&end, 0, sizeof(end));
+    end.ecu = SIM_DIMMER;
+    end.event = SIM_SEQUENCE_END;
+    end.id = SIM_ANY;
+    end.mask = SIM_TAG_MASK;
+    if (Sim_Run(openTime + SIM_MS(SIM_TIMEOUT_MS), &start))
+    {
+      end.data = start.value;
+    }
+    if (start.found && Sim_Run(openTime + SIM_MS(SIM_TIMEOUT_MS), &end))
+    {
+      latency.latency[latency.samples] = end.time - openTime;
+      latency.debounce[latency.samples] = start.time - openTime;
+      latency.samples++;
+    }
+    else
+    {
+      latency.timeouts++;
+    }
+    Sim_Run(Sim_now + SIM_MS(SIM_HOLD_MS), NULL);
+    Sim_MoveDoor(SIM_DOOR_CLOSED, Sim_options.bounces);
+    Sim_Run(Sim_now + SIM_MS(SIM_CLOSED_MS), NULL);
+  }
+  printf("%lu door openings, %lu reached the lamp, %lu lost, %.1f s simulated\n", Sim_options.runs,
+         latency.samples, latency.timeouts, (double)Sim_now / SIM_MS(1000));
+  if (latency.samples)
+  {
+    Sim_PrintPercentiles("debounce", latency.debounce, latency.samples);
+    Sim_PrintPercentiles("door->lamp", latency.latency, latency.samples);
+    Sim_PrintHistogram(&latency);
+  }
+  free(latency.latency);
+  free(latency.debounce);
+  return latency.samples && !latency.timeouts;
+}
+
+/**
+ * @brief Gets the edges the switch driver took for the door switch
+ *
+ * @return unsigned long The number of SEQUENCE_START records of the switch
+ */
+static unsigned long Sim_Edges(void)
+{
+  return Sim_count[SIM_DOOR][SIM_SEQUENCE_START][Sim_options.switchName];
+}
+
+/**
+ * @brief Checks the debouncing of the door switch with bouncing contacts and short glitches
+ *
+ * @return int 1 if the checks passed
+ */
+static int Sim_Debounce(void)
+{
+  unsigned long bounces = Sim_options.bounces ? Sim_options.bounces : SIM_DEFAULT_BOUNCES;
+  unsigned long changes = 0;
+  unsigned long wrongChanges = 0;
+  unsigned long glitches = 0;
+  unsigned long passedGlitches = 0;
+  unsigned long idleRuns = 0;
+  unsigned long edges;
+  unsigned long run;
+  int interrupt;
+  int task = Sim_node[SIM_DOOR].ecu->getSwitchTask(&interrupt);
+  const unsigned char levels[2] = {SIM_DOOR_OPEN, SIM_DOOR_CLOSED};
+  unsigned int move;
+  Sim_Run(SIM_MS(SIM_CLOSED_MS), NULL);
+  for (run = 0; run < Sim_options.runs; run++)
+  {
+    for (move = 0; move < 2; move++)
+    {
+      Sim_Phase();
+      edges = Sim_Edges();
+      Sim_MoveDoor(levels[move], bounces);
+      Sim_Run(Sim_now + SIM_MS(SIM_HOLD_MS), NULL);
+      changes++;
+      wrongChanges += (Sim_Edges() - edges != 1);
+    }
+    Sim_Phase();
+    edges = Sim_Edges();
+    Sim_MoveDoor(SIM_DOOR_OPEN, 0);
+    Sim_Run(Sim_now + SIM_US(Sim_options.glitchUs), NULL);
+    Sim_MoveDoor(SIM_DOOR_CLOSED, 0);
+    Sim_Run(Sim_now + SIM_MS(SIM_HOLD_MS), NULL);
+    glitches++;
+    passedGlitches += (Sim_Edges() != edges);
+    if (task >= 0)
+    {
+      edges = Sim_count[SIM_DOOR][SIM_TASK_START][task];
+      Sim_Run(Sim_now + SIM_MS(SIM_IDLE_MS), NULL);
+      idleRuns += Sim_count[SIM_DOOR][SIM_TASK_START][task] - edges;
+    }
+  }
+  printf("%lu changes bounced %lu times every %lu us, %lu gave other than one edge\n", changes, bounces,
+         Sim_options.bounceUs, wrongChanges);
+  printf("%lu glitches of %lu us, %lu gave an edge\n", glitches, Sim_options.glitchUs, passedGlitches);
+  printf("switch task (%s): %.1f runs per idle second\n", interrupt ? "interrupt" : "polling",
+         (double)idleRuns / Sim_options.runs / (SIM_IDLE_MS / 1000.0));
+  return !wrongChanges && !passedGlitches && !(interrupt && idleRuns);
+}
+
+/**
+ * @brief Waits for the mode switch of an ECU
+ *
+ * @param wait The record to fill
+ * @param ecu The ECU
+ * @param mode The mode
+ * @param until The time to wait up to
+ * @return int 1 if the mode switch was seen
+ */
+static int Sim_WaitMode(simWait_t* wait, int ecu, int mode, simTime_t until)
+{
+  memset(wait, 0, sizeof(*wait));
+  wait->ecu = ecu;
+  wait->event = SIM_MODE_SWITCH;
+  wait->id = mode;
+  wait->data = SIM_ANY;
+  return Sim_Run(until, wait);
+}
+
+/**
+ * @brief Waits for a trace record of any data
+ *
+ * @param wait The record to fill
+ * @param ecu The ECU
+ * @param event The event
+ * @param id The id, SIM_ANY for any id
+ * @param until The time to wait up to
+ * @return int 1 if the record was seen
+ */
+static int Sim_Wait(simWait_t* wait, int ecu, unsigned char event, int id, simTime_t until)
+{
+  memset(wait, 0, sizeof(*wait));
+  wait->ecu = ecu;
+  wait->event = event;
+  wait->id = id;
+  wait->data = SIM_ANY;
+  return Sim_Run(until, wait);
+}
+
+/**
+ * @brief Counts the runnables the dimmer ran
+ *
+ * @return unsigned long The number of RUNNABLE_START records of the dimmer
+ */
+static unsigned long Sim_DimmerRunnables(void)
+{
+  unsigned long count = 0;
+  int id;
+  for (id = 0; id < 256; id++)
+  {
+    count += Sim_count[SIM_DIMMER][SIM_RUNNABLE_START][id];
+  }
+  return count;
+}
+
+/**
+ * @brief Counts the tasks the door ECU ran but its switch task
+ *
+ * @return unsigned long The number of TASK_START records of the other tasks of the door
+ */
+static unsigned long Sim_DoorTasks(void)
+{
+  unsigned long count = 0;
+  int interrupt;
+  int switchTask = Sim_node[SIM_DOOR].ecu->getSwitchTask(&interrupt);
+  int id;
+  for (id = 0; id < 256; id++)
+  {
+    if (id != switchTask)
+    {
+      count += Sim_count[SIM_DOOR][SIM_TASK_START][id];
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Checks that the dimmer follows the vehicle mode of the door ECU
+ *        and that the door only watches its switches while it sleeps
+ *
+ * @return int 1 if the checks passed
+ */
+static int Sim_Mode(void)
+{
+  simWait_t doorSleep;
+  simWait_t dimmerSleep;
+  simWait_t wake;
+  simWait_t start;
+  simWait_t end;
+  simTime_t* silence = calloc(Sim_options.runs, sizeof(simTime_t));
+  simTime_t* latency = calloc(Sim_options.runs, sizeof(simTime_t));
+  unsigned long sleeps = 0;
+  unsigned long wakes = 0;
+  unsigned long bytes = 0;
+  unsigned long runnables = 0;
+  unsigned long tasks = 0;
+  unsigned long sent;
+  unsigned long ran;
+  unsigned long doorRan;
+  unsigned long run;
+  simTime_t openTime;
+  for (run = 0; run < Sim_options.runs; run++)
+  {
+    if (Sim_WaitMode(&doorSleep, SIM_DOOR, SIM_MODE_SLEEP, Sim_now + SIM_MS(SIM_SLEEP_MS)) &&
+        Sim_WaitMode(&dimmerSleep, SIM_DIMMER, SIM_MODE_SLEEP, Sim_now + SIM_MS(SIM_TIMEOUT_MS)))
+    {
+      silence[sleeps++] = dimmerSleep.time - doorSleep.time;
+    }
+    sent = Sim_node[SIM_DOOR].wire.sent;
+    ran = Sim_DimmerRunnables();
+    doorRan = Sim_DoorTasks();
+    Sim_Run(Sim_now + SIM_MS(SIM_IDLE_MS), NULL);
+    bytes += Sim_node[SIM_DOOR].wire.sent - sent;
+    runnables += Sim_DimmerRunnables() - ran;
+    tasks += Sim_DoorTasks() - doorRan;
+    Sim_Phase();
+    Sim_MoveDoor(SIM_DOOR_OPEN, Sim_options.bounces);
+    openTime = Sim_now;
+    memset(&start, 0, sizeof(start));
+    start.ecu = SIM_DOOR;
+    start.event = SIM_SEQUENCE_START;
+    start.id = Sim_options.switchName;
+    start.data = SIM_ANY;
+    memset(&end, 0, sizeof(end));
+    end.ecu = SIM_DIMMER;
+    end.event = SIM_SEQUENCE_END;
+    end.id = SIM_ANY;
+    end.mask = SIM_TAG_MASK;
+    if (Sim_Run(openTime + SIM_MS(SIM_TIMEOUT_MS), &start) &&
+        Sim_WaitMode(&wake, SIM_DIMMER, SIM_MODE_RUN, openTime + SIM_MS(SIM_TIMEOUT_MS)))
+    {
+      end.data = start.value;
+      if (Sim_Run(openTime + SIM_MS(SIM_TIMEOUT_MS), &end))
+      {
+        latency[wakes++] = end.time - openTime;
+      }
+    }
+    Sim_Run(Sim_now + SIM_MS(SIM_HOLD_MS), NULL);
+    Sim_MoveDoor(SIM_DOOR_CLOSED, Sim_options.bounces);
+  }
+  printf("%lu sleeps, the dimmer followed %lu, %lu bytes sent and %lu dimmer runnables run while asleep\n",
+         Sim_options.runs, sleeps, bytes, runnables);
+  printf("%lu door tasks but the switch task run while asleep\n", tasks);
+  printf("%lu door openings from sleep, %lu woke the dimmer and reached the lamp, %.1f s simulated\n",
+         Sim_options.runs, wakes, (double)Sim_now / SIM_MS(1000));
+  if (sleeps)
+  {
+    Sim_PrintPercentiles("silence", silence, sleeps);
+  }
+  if (wakes)
+  {
+    Sim_PrintPercentiles("door->lamp", latency, wakes);
+  }
+  free(silence);
+  free(latency);
+  return sleeps == Sim_options.runs && wakes == Sim_options.runs && !bytes && !runnables && !tasks;
+}
+
+/**
+ * @brief Counts the ticks of the dimmer
+ *
+ * @return unsigned long The number of TASK_START records of the server task of the dimmer
+ */
+static unsigned long Sim_DimmerTicks(void)
+{
+  return Sim_count[SIM_DIMMER][SIM_TASK_START][SIM_SERVER_TASK];
+}
+
+/**
+ * @brief Checks that the timeouts of the dimmer turn the lamp off on time without polling
+ *        The close delay and the battery saver count from the run of the dimmer that saw the door
+ *        and are checked in ticks of the scheduler, the time of Timer0 is printed next to them
+ *
+ * @return int 1 if the checks passed
+ */
+static int Sim_Dimmer(void)
+{
+  simWait_t seen;
+  simWait_t lamp;
+  simTime_t delay = 0;
+  simTime_t saver = 0;
+  unsigned long delayMs = 0;
+  unsigned long saverMs = 0;
+  unsigned long ticks;
+  unsigned long ran;
+  unsigned long runs;
+  Sim_Run(SIM_MS(SIM_CLOSED_MS), NULL);
+  ran = Sim_count[SIM_DIMMER][SIM_RUNNABLE_START][SIM_DIMMER_RUNNABLE];
+  Sim_MoveDoor(SIM_DOOR_OPEN, Sim_options.bounces);
+  Sim_Run(Sim_now + SIM_MS(SIM_HOLD_MS), NULL);
+  Sim_MoveDoor(SIM_DOOR_CLOSED, Sim_options.bounces);
+  if (Sim_Wait(&seen, SIM_DIMMER, SIM_RUNNABLE_START, SIM_DIMMER_RUNNABLE, Sim_now + SIM_MS(SIM_TIMEOUT_MS)))
+  {
+    ticks = Sim_DimmerTicks();
+    if (Sim_Wait(&lamp, SIM_DIMMER, SIM_SEQUENCE_END, SIM_ANY, seen.time + SIM_MS(SIM_TICKS_MS(SIM_DELAY_MS) + SIM_TIMEOUT_MS)))
+    {
+      delay = lamp.time - seen.time;
+      delayMs = (Sim_DimmerTicks() - ticks) * SIM_TICK_MS;
+    }
+  }
+  /* The lamp goes on then off when the battery saver expires */
+  Sim_MoveDoor(SIM_DOOR_OPEN, Sim_options.bounces);
+  if (Sim_Wait(&seen, SIM_DIMMER, SIM_RUNNABLE_START, SIM_DIMMER_RUNNABLE, Sim_now + SIM_MS(SIM_TIMEOUT_MS)))
+  {
+    ticks = Sim_DimmerTicks();
+    if (Sim_Wait(&lamp, SIM_DIMMER, SIM_SEQUENCE_END, SIM_ANY, seen.time + SIM_MS(SIM_TIMEOUT_MS)) &&
+        Sim_Wait(&lamp, SIM_DIMMER, SIM_SEQUENCE_END, SIM_ANY, seen.time + SIM_MS(SIM_TICKS_MS(SIM_SAVER_MS) + SIM_TIMEOUT_MS)))
+    {
+      saver = lamp.time - seen.time;
+      saverMs = (Sim_DimmerTicks() - ticks) * SIM_TICK_MS;
+    }
+  }
+  Sim_MoveDoor(SIM_DOOR_CLOSED, Sim_options.bounces);
+  Sim_Run(Sim_now + SIM_MS(SIM_CLOSED_MS), NULL);
+  runs = Sim_count[SIM_DIMMER][SIM_RUNNABLE_START][SIM_DIMMER_RUNNABLE] - ran;
+  printf("close delay %lu ms of ticks (%.3f s of Timer0), battery saver %lu ms of ticks (%.3f s of Timer0)\n",
+         delayMs, (double)delay / SIM_MS(1000), saverMs, (double)saver / SIM_MS(1000));
+  printf("%lu dimmer runs for %d door changes and timeouts, %.1f s simulated\n", runs, SIM_DIMMER_RUNS,
+         (double)Sim_now / SIM_MS(1000));
+  return delayMs >= SIM_DELAY_MS && delayMs <= SIM_DELAY_MS + SIM_LATE_MS && saverMs >= SIM_SAVER_MS &&
+         saverMs <= SIM_SAVER_MS + SIM_LATE_MS && runs == SIM_DIMMER_RUNS;
+}
+
+/**
+ * @brief Runs the simulation until the message of the tp scenario ended on both ECUs
+ *        The door ended its transmission and the dimmer has no reception in progress
+ *
+ * @param until The time to wait up to
+ * @param door Save the counters of the door in
+ * @param dimmer Save the counters of the dimmer in
+ * @param doorEnds The transmissions the door ended before the message
+ * @return int 1 if the message ended
+ */
+static int Sim_RunTp(simTime_t until, simTpStats_t* door, simTpStats_t* dimmer, unsigned long doorEnds)
+{
+  int ended = 0;
+  while (!ended && Sim_now < until)
+  {
+    Sim_Step(until);
+    Sim_node[SIM_DOOR].ecu->getTpStats(door);
+    Sim_node[SIM_DIMMER].ecu->getTpStats(dimmer);
+    ended = door->txDone + door->txAborted != doorEnds &&
+            dimmer->rxDone + dimmer->rxAborted == dimmer->rxStarted;
+  }
+  return ended;
+}
+
+/**
+ * @brief Measures the throughput of the Transport Protocol from the door to the dimmer
+ *        The door is held open so the door ECU does not sleep and stop its link task
+ *
+ * @return int 1 if the checks passed
+ */
+static int Sim_Tp(void)
+{
+  simTime_t* transfer = calloc(Sim_options.runs, sizeof(simTime_t));
+  simTpStats_t door;
+  simTpStats_t dimmer;
+  simTime_t start;
+  double sum = 0;
+  unsigned long whole = 0;
+  unsigned long stuck = 0;
+  unsigned long received;
+  unsigned long flowControls;
+  unsigned long run;
+  int clean = Sim_options.dropRate == 0 && Sim_options.bitErrorRate == 0 && Sim_options.framingErrorRate == 0 &&
+              Sim_options.baud[SIM_DOOR] == Sim_options.baud[SIM_DIMMER];
+  /* The door is opened once its switch task runs, an edge before it is not seen */
+  Sim_Run(SIM_MS(SIM_HOLD_MS), NULL);
+  Sim_MoveDoor(SIM_DOOR_OPEN, 0);
+  Sim_Run(Sim_now + SIM_MS(SIM_TP_START_MS), NULL);
+  Sim_node[SIM_DIMMER].ecu->setTpSink(Sim_options.sinkRate, Sim_options.sinkSize);
+  Sim_node[SIM_DOOR].ecu->getTpStats(&door);
+  Sim_node[SIM_DIMMER].ecu->getTpStats(&dimmer);
+  flowControls = Sim_node[SIM_DIMMER].wire.sent;
+  for (run = 0; run < Sim_options.runs; run++)
+  {
+    Sim_Phase();
+    received = dimmer.rxDone;
+    if (!Sim_node[SIM_DOOR].ecu->tpTransmit((unsigned int)Sim_options.tpLength))
+    {
+      fprintf(stderr, "sim: the door cannot send a message, build the images with -DUART_LINK=UART_LINK_TP\n");
+      stuck++;
+      break;
+    }
+    start = Sim_now;
+    if (!Sim_RunTp(start + SIM_MS(SIM_TP_TIMEOUT_MS), &door, &dimmer, door.txDone + door.txAborted))
+    {
+      stuck++;
+    }
+    if (dimmer.rxDone != received)
+    {
+      transfer[whole++] = dimmer.rxEnd - start;
+      sum += (double)(dimmer.rxEnd - start);
+    }
+  }
+  flowControls = (Sim_node[SIM_DIMMER].wire.sent - flowControls) / SIM_TP_FRAME_SIZE;
+  printf("%lu messages of %lu bytes, %lu received whole, %lu stuck, %.1f s simulated\n", Sim_options.runs,
+         Sim_options.tpLength, whole, stuck, (double)Sim_now / SIM_MS(1000));
+  printf("door: %lu confirmed, %lu aborted, %lu confirmed before the UART was done\n", door.txDone,
+         door.txAborted, door.txEarly);
+  printf("dimmer: %lu aborted, %lu wrong bytes, %lu pieces refused by a sink of %lu bytes at %lu B/s, "
+         "%lu flow controls\n", dimmer.rxAborted, dimmer.rxWrong, dimmer.rxRefused, Sim_options.sinkSize,
+         Sim_options.sinkRate, flowControls);
+  if (whole)
+  {
+    printf("throughput %8.1f B/s\n", (double)Sim_options.tpLength * whole / (sum / SIM_MS(1000)));
+    Sim_PrintPercentiles("transfer", transfer, whole);
+  }
+  free(transfer);
+  return !stuck && !door.txEarly && ((whole == Sim_options.runs && !dimmer.rxWrong) || !clean);
+}
+
+/**
+ * @brief Prints the usage of the simulation
+ *
+ */
+static void Sim_Usage(void)
+{
+  fprintf(stderr,
+          "usage: sim [options]\n"
+          "  --door PATH          the door image (door.so next to sim)\n"
+          "  --dimmer PATH        the dimmer image (dimmer.so next to sim)\n"
+          "  --runs N             the door openings to measure (50)\n"
+          "  --seed N             the seed of the phases and the errors (1)\n"
+          "  --switch N           the door switch that is opened (0)\n"
+          "  --door-baud N        runs the door UART at a baud rate instead of UBRR\n"
+          "  --dimmer-baud N      runs the dimmer UART at a baud rate instead of UBRR\n"
+          "  --delay-us N         the propagation delay of the wire (0)\n"
+          "  --phase-us N         starts the dimmer this much after the door (0)\n"
+          "  --ber X              the probability of a flipped bit (0)\n"
+          "  --framing-errors X   the probability of a framing error per byte (0)\n"
+          "  --drop X             the probability of a lost byte (0)\n"
+          "  --bucket-us N        the width of the histogram buckets (1000)\n"
+          "  --scenario NAME      latency, debounce, mode, dimmer or tp (latency)\n"
+          "  --bounces N          the bounces of the door contact on every move (0, 5 for debounce)\n"
+          "  --bounce-us N        the time between two toggles of a bouncing contact (1000)\n"
+          "  --glitch-us N        the glitches of the debounce scenario (10000)\n"
+          "  --tp-length N        the length of the messages of the tp scenario (4095)\n"
+          "  --sink N             the bytes per second the dimmer drains from its sink, 0 takes all at once (0)\n"
+          "  --sink-size N        the bytes the sink of the dimmer holds (128)\n");
+}
+
+/**
+ * @brief Reads the options of the command line
+ *
+ * @param argc The number of the arguments
+ * @param argv The arguments
+ * @return int 1 if the options are valid
+ */
+static int Sim_ParseOptions(int argc, char** argv)
+{
+  static char paths[SIM_NUMBER_OF_ECUS][4096];
+  const char* slash = strrchr(argv[0], '/');
+  int directory = slash ? (int)(slash - argv[0] + 1) : 0;
+  int itr;
+  snprintf(paths[SIM_DOOR], sizeof(paths[SIM_DOOR]), "%.*sdoor.so", directory, argv[0]);
+  snprintf(paths[SIM_DIMMER], sizeof(paths[SIM_DIMMER]), "%.*sdimmer.so", directory, argv[0]);
+  if (!directory)
+  {
+    snprintf(paths[SIM_DOOR], sizeof(paths[SIM_DOOR]), "./door.so");
+    snprintf(paths[SIM_DIMMER], sizeof(paths[SIM_DIMMER]), "./dimmer.so");
+  }
+  Sim_options.image[SIM_DOOR] = paths[SIM_DOOR];
+  Sim_options.image[SIM_DIMMER] = paths[SIM_DIMMER];
+  Sim_options.runs = 50;
+  Sim_options.seed = 1;
+  Sim_options.bucketUs = 1000;
+  Sim_options.scenario = "latency";
+  Sim_options.bounceUs = 1000;
+  Sim_options.glitchUs = 10000;
+  Sim_options.tpLength = 4095;
+  Sim_options.sinkSize = 128;
+  for (itr = 1; itr < argc; itr++)
+  {
+    const char* value = (itr + 1 < argc) ? argv[itr + 1] : NULL;
+    if (!value)
+    {
+      return 0;
+    }
+    if (!strcmp(argv[itr], "--door"))
+    {
+      Sim_options.image[SIM_DOOR] = value;
+    }
+    else if (!strcmp(argv[itr], "--dimmer"))
+    {
+      Sim_options.image[SIM_DIMMER] = value;
+    }
+    else if (!strcmp(argv[itr], "--runs"))
+    {
+      Sim_options.runs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--seed"))
+    {
+      Sim_options.seed = strtoull(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--switch"))
+    {
+      Sim_options.switchName = (unsigned char)strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--door-baud"))
+    {
+      Sim_options.baud[SIM_DOOR] = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--dimmer-baud"))
+    {
+      Sim_options.baud[SIM_DIMMER] = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--delay-us"))
+    {
+      Sim_options.delayUs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--phase-us"))
+    {
+      Sim_options.phaseUs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--ber"))
+    {
+      Sim_options.bitErrorRate = strtod(value, NULL);
+    }
+    else if (!strcmp(argv[itr], "--framing-errors"))
+    {
+      Sim_options.framingErrorRate = strtod(value, NULL);
+    }
+    else if (!strcmp(argv[itr], "--drop"))
+    {
+      Sim_options.dropRate = strtod(value, NULL);
+    }
+    else if (!strcmp(argv[itr], "--bucket-us"))
+    {
+      Sim_options.bucketUs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--scenario"))
+    {
+      Sim_options.scenario = value;
+    }
+    else if (!strcmp(argv[itr], "--bounces"))
+    {
+      Sim_options.bounces = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--bounce-us"))
+    {
+      Sim_options.bounceUs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--glitch-us"))
+    {
+      Sim_options.glitchUs = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--tp-length"))
+    {
+      Sim_options.tpLength = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--sink"))
+    {
+      Sim_options.sinkRate = strtoul(value, NULL, 0);
+    }
+    else if (!strcmp(argv[itr], "--sink-size"))
+    {
+      Sim_options.sinkSize = strtoul(value, NULL, 0);
+    }
+    else
+    {
+      return 0;
+    }
+    itr++;
+  }
+  return Sim_options.runs > 0 && Sim_options.bucketUs > 0 &&
+         (!strcmp(Sim_options.scenario, "latency") || !strcmp(Sim_options.scenario, "debounce") ||
+          !strcmp(Sim_options.scenario, "mode") || !strcmp(Sim_options.scenario, "dimmer") ||
+          !strcmp(Sim_options.scenario, "tp"));
+}
+
+int main(int argc, char** argv)
+{
+  unsigned char port;
+  unsigned char pin;
+  int itr;
+  int passed;
+  if (!Sim_ParseOptions(argc, argv))
+  {
+    Sim_Usage();
+    return 2;
+  }
+  Sim_random = Sim_options.seed ? Sim_options.seed : 1;
+  for (itr = 0; itr < SIM_NUMBER_OF_ECUS; itr++)
+  {
+    Sim_node[itr].ecu = Sim_Load(Sim_options.image[itr]);
+    if (!Sim_node[itr].ecu)
+    {
+      return 2;
+    }
+    Sim_node[itr].ecu->setTxHook(Sim_Transmit, &Sim_node[itr]);
+    Sim_node[itr].ecu->setBaud(Sim_options.baud[itr]);
+  }
+  if (!Sim_node[SIM_DOOR].ecu->getSwitch(Sim_options.switchName, &Sim_port, &Sim_pin))
+  {
+    fprintf(stderr, "sim: the door image has no switch %u\n", Sim_options.switchName);
+    return 2;
+  }
+  /* Every door starts closed */
+  for (itr = 0; Sim_node[SIM_DOOR].ecu->getSwitch((unsigned char)itr, &port, &pin); itr++)
+  {
+    Sim_node[SIM_DOOR].ecu->drive(port, pin, SIM_DOOR_CLOSED);
+  }
+  Sim_node[SIM_DOOR].origin = 0;
+  Sim_node[SIM_DIMMER].origin = SIM_US(Sim_options.phaseUs);
+  if (!strcmp(Sim_options.scenario, "debounce"))
+  {
+    passed = Sim_Debounce();
+  }
+  else if (!strcmp(Sim_options.scenario, "mode"))
+  {
+    passed = Sim_Mode();
+  }
+  else if (!strcmp(Sim_options.scenario, "dimmer"))
+  {
+    passed = Sim_Dimmer();
+  }
+  else if (!strcmp(Sim_options.scenario, "tp"))
+  {
+    passed = Sim_Tp();
+  }
+  else
+  {
+    passed = Sim_Latency();
+  }
+  Sim_PrintLink("door", &Sim_node[SIM_DOOR]);
+  Sim_PrintLink("dimmer", &Sim_node[SIM_DIMMER]);
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,856 @@
+/**
+ * @file SimEcu.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the hardware of an ECU image of the host simulation
+ *        It is built into every image with HOST_SIM and GPIO_HOST_BACKEND and plays the parts of the ATMEGA32
+ *        the drivers use on the register file of the image
+ *          Timer0 and Timer2 : the counters advance with the time, the compare match and overflow set their
+ *                              flags in TIFR and call the handlers like the CPU would
+ *          UART : a byte written to UDR takes its frame time on the line and the transmission complete
+ *                 handler runs at its end, a received byte is put in UDR with its line errors in UCSRA
+ *          Pins : GpioHost.c plays the pins and the external interrupts
+ *        With UART_LINK_TP it is also the user of the Transport Protocol, it sends messages of a counting pattern
+ *        and puts the received ones in a sink drained at a fixed rate, refusing the pieces that do not fit
+ *        The tasks and the handlers take no time, so the time only moves between two events
+ * @version 0.1
+ * @date 2020-05-02
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Reg_Access.h"
+#include "Sched_Cfg.h"
+#include "Sched.h"
+#include "Uart_Cfg.h"
+#include "Uart.h"
+#include "Tp.h"
+#include "Gpio.h"
+#include "GpioHost.h"
+#include "Switch.h"
+#include "Trace.h"
+#include "SimEcu.h"
+
+#if SWITCH_DETECTION == SWITCH_DETECTION_INTERRUPT
+#define SIM_SWITCH_INTERRUPT        1
+#else
+#define SIM_SWITCH_INTERRUPT        0
+#endif
+
+#if UART_LINK == UART_LINK_TP
+#define SIM_TP_LINK                 1
+#else
+#define SIM_TP_LINK                 0
+#endif
+
+/* The room a sink without a rate reports, it takes every piece */
+#define SIM_TP_SINK_UNLIMITED       0xFFFF
+
+#define SIM_UBRRL                   0x29
+#define SIM_UCSRB                   0x2A
+#define SIM_UCSRA                   0x2B
+#define SIM_UDR                     0x2C
+#define SIM_UCSRC                   0x40
+#define SIM_TIFR                    0x58
+#define SIM_TIMSK                   0x59
+#define SIM_SREG                    0x5F
+
+#define SIM_GIE                     0x80
+#define SIM_CLOCK_SELECT            0x07
+#define SIM_CTC_MODE                0x08
+#define SIM_COUNTER_MAX             0xFF
+
+#define SIM_RXC                     0x80
+#define SIM_DATA_OVERRUN            0x08
+#define SIM_RXCIE                   0x80
+#define SIM_TXCIE                   0x40
+#define SIM_RX_EN                   0x10
+#define SIM_TX_EN                   0x08
+#define SIM_PARITY                  0x30
+#define SIM_TWO_STOP_BITS           0x08
+
+/* A frame has a start bit, 8 data bits, the parity bit and the stop bits */
+#define SIM_UART_BITS(format)       (10 + (((format) & SIM_PARITY) ? 1 : 0) + (((format) & SIM_TWO_STOP_BITS) ? 1 : 0))
+/* The receiver samples the middle of the bits so the bit times may differ by a few percent */
+#define SIM_UART_TOLERANCE          25
+
+#define SIM_TIMER0                  0
+#define SIM_TIMER2                  1
+#define SIM_NUMBER_OF_TIMERS        2
+
+#define SIM_TRACE_SIZE              4096
+
+typedef struct
+{
+    uint8_t control;            /* TCCRn */
+    uint8_t counter;            /* TCNTn */
+    uint8_t compare;            /* OCRn */
+    uint8_t compareFlag;        /* OCFn of TIFR and OCIEn of TIMSK */
+    uint8_t overflowFlag;       /* TOVn of TIFR and TOIEn of TIMSK */
+    const uint16_t* prescaler;  /* The division of every clock select, 0 if the timer does not count */
+} simTimer_t;
+
+typedef void (*simVector_t)(void);
+
+void __vector_4 (void);
+void __vector_5 (void);
+void __vector_10 (void);
+void __vector_13 (void);
+void __vector_15 (void);
+
+extern const switch_t Switch_switches[SWITCH_NUMBER_OF_SWITCHES];
+extern const task_t Switch_task;
+extern const sysTaskInfo_t Sched_sysTaskInfo[SCHED_NUMBER_OF_TASKS];
+
+volatile uint8_t Sim_registers[REG_FILE_SIZE];
+
+static const uint16_t SimEcu_prescaler0[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+static const uint16_t SimEcu_prescaler2[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+static const simTimer_t SimEcu_timer[SIM_NUMBER_OF_TIMERS] = {
+    /*Control   Counter     Compare     Compare flag    Overflow flag   Prescaler*/
+    {0x53,      0x52,       0x5C,       0x02,           0x01,           SimEcu_prescaler0},
+    {0x45,      0x44,       0x43,       0x80,           0x40,           SimEcu_prescaler2}
+};
+
+/* The interrupts played here in the order of their vectors with their flag and enable bits */
+typedef struct
+{
+    simVector_t vector;
+    uint8_t flag;       /* The flag in TIFR, 0 for the UART */
+} simInterrupt_t;
+
+static const simInterrupt_t SimEcu_timerInterrupt[3] = {
+    {__vector_4,    0x80},  /* TIMER2 COMP */
+    {__vector_5,    0x40},  /* TIMER2 OVF */
+    {__vector_10,   0x02}   /* TIMER0 COMP */
+};
+
+/* The current time, the start of the image which is the origin of the prescalers
+   and the time the counters in the registers belong to */
+static simTime_t SimEcu_now;
+static simTime_t SimEcu_origin;
+static simTime_t SimEcu_synced;
+
+/* The time of the pins in the micro seconds of GpioHost */
+#define SIM_PIN_TIME(time)          ((unsigned long)(((time) - SimEcu_origin) / SIM_ECU_CYCLES_PER_US))
+
+static simTime_t SimEcu_txEnd = SIM_ECU_NO_EVENT;
+static uint8_t SimEcu_txComplete;
+static uint8_t SimEcu_rxFull;
+static unsigned long SimEcu_baud;
+static simTxHook_t SimEcu_txHook;
+static void* SimEcu_txContext;
+
+static uint8_t SimEcu_traceTail;
+static simTrace_t SimEcu_trace[SIM_TRACE_SIZE];
+static unsigned long SimEcu_traceHead;
+static unsigned long SimEcu_traceCount;
+static unsigned long SimEcu_traceLost;
+
+static simTpStats_t SimEcu_tp;
+static uint16_t SimEcu_tpTxOffset;
+static uint16_t SimEcu_tpRxOffset;
+static uint16_t SimEcu_tpRxLength;
+static unsigned long SimEcu_tpRxWrong;
+static unsigned long SimEcu_sinkRate;
+static unsigned long SimEcu_sinkSize;
+static unsigned long SimEcu_sinkFill;
+static simTime_t SimEcu_sinkTime;
+
+/**
+ * @brief Gets the division of the clock of a timer
+ *
+ * @param timer The timer
+ * @return uint16_t The division, 0 if the timer is stopped
+ */
+static uint16_t SimEcu_Prescaler(const simTimer_t* timer)
+{
+    return timer->prescaler[Sim_registers[timer->control] & SIM_CLOCK_SELECT];
+}
+
+/**
+ * @brief Gets the number of counts a timer makes until its next compare match or overflow
+ *        A flag is raised when the counter leaves the compare value or the top,
+ *        in CTC mode the top is the compare value and the counter goes back to 0 from it
+ *
+ * @param timer The timer
+ * @return uint16_t The counts
+ */
+static uint16_t SimEcu_CountsToEvent(const simTimer_t* timer)
+{
+    uint16_t count = Sim_registers[timer->counter];
+    uint16_t compare = Sim_registers[timer->compare];
+    uint16_t top = SIM_COUNTER_MAX;
+    uint16_t toCompare;
+    if((Sim_registers[timer->control] & SIM_CTC_MODE) && count <= compare)
+    {
+        top = compare;
+    }
+    toCompare = (count <= compare) ? compare - count + 1 : (SIM_COUNTER_MAX - count + 1) + compare + 1;
+    return (toCompare < top - count + 1) ? toCompare : top - count + 1;
+}
+
+/**
+ * @brief Advances a timer by some counts that end at or before its next event
+ *
+ * @param timer The timer
+ * @param counts The counts
+ */
+static void SimEcu_Count(const simTimer_t* timer, simTime_t counts)
+{
+    uint16_t count = Sim_registers[timer->counter];
+    uint16_t compare = Sim_registers[timer->compare];
+    uint16_t top = SIM_COUNTER_MAX;
+    if((Sim_registers[timer->control] & SIM_CTC_MODE) && count <= compare)
+    {
+        top = compare;
+    }
+    if(count + counts - 1 == compare)
+    {
+        Sim_registers[SIM_TIFR] |= timer->compareFlag;
+    }
+    if(count + counts - 1 == top)
+    {
+        Sim_registers[timer->counter] = 0;
+        if(top == SIM_COUNTER_MAX)
+        {
+            Sim_registers[SIM_TIFR] |= timer->overflowFlag;
+        }
+    }
+    else
+    {
+        Sim_registers[timer->counter] = (uint8_t)(count + counts);
+    }
+}
+
+/**
+ * @brief Gets the counts of a prescaler between two times, the counts are aligned to the start of the image
+ *
+ * @param prescaler The division of the clock
+ * @param from The first time
+ * @param to The second time
+ * @return simTime_t The counts
+ */
+static simTime_t SimEcu_Counts(uint16_t prescaler, simTime_t from, simTime_t to)
+{
+    return (to - SimEcu_origin) / prescaler - (from - SimEcu_origin) / prescaler;
+}
+
+/**
+ * @brief Brings the counters of the timers to the current time raising the flags they pass
+ *
+ */
+static void SimEcu_SyncTimers(void)
+{
+    uint8_t i;
+    uint16_t prescaler;
+    simTime_t counts;
+    simTime_t next;
+    for(i=0; i<SIM_NUMBER_OF_TIMERS; i++)
+    {
+        prescaler = SimEcu_Prescaler(&SimEcu_timer[i]);
+        if(prescaler)
+        {
+            counts = SimEcu_Counts(prescaler, SimEcu_synced, SimEcu_now);
+            while(counts)
+            {
+                next = SimEcu_CountsToEvent(&SimEcu_timer[i]);
+                next = (next < counts) ? next : counts;
+                SimEcu_Count(&SimEcu_timer[i], next);
+                counts -= next;
+            }
+        }
+    }
+    SimEcu_synced = SimEcu_now;
+}
+
+/**
+ * @brief Gets the time of the next compare match or overflow of a timer
+ *
+ * @param timer The timer
+ * @return simTime_t The time or SIM_ECU_NO_EVENT if the timer is stopped
+ */
+static simTime_t SimEcu_TimerEvent(const simTimer_t* timer)
+{
+    simTime_t time = SIM_ECU_NO_EVENT;
+    uint16_t prescaler = SimEcu_Prescaler(timer);
+    if(prescaler)
+    {
+        time = ((SimEcu_synced - SimEcu_origin) / prescaler + SimEcu_CountsToEvent(timer)) * prescaler + SimEcu_origin;
+    }
+    return time;
+}
+
+/**
+ * @brief Gets the cycles of a UART frame
+ *
+ * @return simTime_t The cycles from the start bit to the end of the stop bits
+ */
+static simTime_t SimEcu_FrameCycles(void)
+{
+    simTime_t bitCycles = 16 * ((simTime_t)Sim_registers[SIM_UBRRL] + 1);
+    if(SimEcu_baud)
+    {
+        bitCycles = SIM_ECU_CLOCK_HZ / SimEcu_baud;
+    }
+    return bitCycles * SIM_UART_BITS(Sim_registers[SIM_UCSRC]);
+}
+
+/**
+ * @brief Calls an interrupt handler with the global interrupts disabled like the CPU does
+ *
+ * @param vector The handler
+ */
+static void SimEcu_Vector(simVector_t vector)
+{
+    uint8_t sreg = Sim_registers[SIM_SREG];
+    Sim_registers[SIM_SREG] = sreg & ~SIM_GIE;
+    vector();
+    Sim_registers[SIM_SREG] |= SIM_GIE;
+}
+
+/**
+ * @brief Copies the new records of the trace of the image so the harness does not have to keep up with it
+ *
+ */
+static void SimEcu_DrainTrace(void)
+{
+    traceRecord_t* record;
+    simTrace_t* copy;
+    uint32_t ticks;
+    uint32_t timeUs;
+    while(SimEcu_traceTail != Trace_log.head)
+    {
+        record = &Trace_log.record[SimEcu_traceTail];
+        if(SimEcu_traceCount == SIM_TRACE_SIZE)
+        {
+            /* The oldest record makes room for the new one */
+            SimEcu_traceHead = (SimEcu_traceHead + 1) % SIM_TRACE_SIZE;
+            SimEcu_traceCount--;
+            SimEcu_traceLost++;
+        }
+        copy = &SimEcu_trace[(SimEcu_traceHead + SimEcu_traceCount) % SIM_TRACE_SIZE];
+        copy->event = record->event;
+        copy->id = record->id;
+        copy->data = record->data;
+        ticks = (uint32_t)record->ticks[0] | ((uint32_t)record->ticks[1] << 8) |
+                ((uint32_t)(record->ticks[2] & ~TRACE_TICKS_PENDING) << 16);
+        if(record->ticks[2] & TRACE_TICKS_PENDING)
+        {
+            ticks++;
+        }
+        Timer0_TicksToUs(ticks, record->count, &timeUs);
+        copy->timeUs = timeUs;
+        SimEcu_traceCount++;
+        SimEcu_traceTail = (SimEcu_traceTail + 1) & (TRACE_BUFFER_SIZE - 1);
+    }
+}
+
+/**
+ * @brief Calls the handlers of the pending interrupts that are enabled
+ *
+ * @return uint8_t 1 if a handler ran
+ */
+static uint8_t SimEcu_Interrupts(void)
+{
+    uint8_t i;
+    uint8_t ran = 0;
+    uint8_t pending = 1;
+    while(pending && (Sim_registers[SIM_SREG] & SIM_GIE))
+    {
+        pending = 0;
+        for(i=0; i<3 && !pending; i++)
+        {
+            if(Sim_registers[SIM_TIFR] & Sim_registers[SIM_TIMSK] & SimEcu_timerInterrupt[i].flag)
+            {
+                Sim_registers[SIM_TIFR] &= ~SimEcu_timerInterrupt[i].flag;
+                SimEcu_Vector(SimEcu_timerInterrupt[i].vector);
+                pending = 1;
+            }
+        }
+        if(!pending && SimEcu_rxFull && (Sim_registers[SIM_UCSRB] & SIM_RXCIE))
+        {
+            /* The handler reads UDR, which clears the flags of the byte */
+            SimEcu_Vector(__vector_13);
+            SimEcu_rxFull = 0;
+            Sim_registers[SIM_UCSRA] = 0;
+            pending = 1;
+        }
+        if(!pending && SimEcu_txComplete && (Sim_registers[SIM_UCSRB] & SIM_TXCIE))
+        {
+            SimEcu_txComplete = 0;
+            SimEcu_Vector(__vector_15);
+            pending = 1;
+        }
+        ran |= pending;
+    }
+    return ran;
+}
+
+/**
+ * @brief Runs what the image does at the current time, the handlers of the raised flags then the tick
+ *        of the scheduler they flagged, like the loop of Sched_Start
+ *
+ */
+static void SimEcu_Service(void)
+{
+    SimEcu_Interrupts();
+    Sched_Step();
+    SimEcu_Interrupts();
+    SimEcu_DrainTrace();
+}
+
+/**
+ * @brief Gets a byte of the counting pattern of the messages of the Transport Protocol
+ *
+ * @param offset The offset of the byte in the message
+ * @return uint8_t The byte
+ */
+static uint8_t SimEcu_TpByte(uint16_t offset)
+{
+    return (uint8_t)(offset + (offset >> 8));
+}
+
+/**
+ * @brief Fills the next piece of the message being sent
+ *
+ * @param data The piece
+ * @param length The length of the piece
+ * @return Std_ReturnType E_OK
+ */
+static Std_ReturnType SimEcu_TpTxCopy(uint8_t* data, uint8_t length)
+{
+    uint8_t i;
+    for(i=0; i<length; i++)
+    {
+        data[i] = SimEcu_TpByte(SimEcu_tpTxOffset++);
+    }
+    return E_OK;
+}
+
+/**
+ * @brief Counts the end of a transmission, E_OK must come after the UART sent the last byte
+ *
+ * @param result The result of the transmission
+ */
+static void SimEcu_TpTxConfirmation(Std_ReturnType result)
+{
+    if(result == E_OK)
+    {
+        SimEcu_tp.txDone++;
+        SimEcu_tp.txEarly += (SimEcu_txEnd != SIM_ECU_NO_EVENT);
+    }
+    else
+    {
+        SimEcu_tp.txAborted++;
+    }
+    SimEcu_tp.txEnd = SimEcu_now;
+}
+
+/**
+ * @brief Starts a reception with an empty sink
+ *
+ * @param length The length of the message
+ * @return Std_ReturnType E_OK
+ */
+static Std_ReturnType SimEcu_TpRxStart(uint16_t length)
+{
+    SimEcu_tp.rxStarted++;
+    SimEcu_tpRxOffset = 0;
+    SimEcu_tpRxLength = length;
+    SimEcu_tpRxWrong = SimEcu_tp.rxWrong;
+    SimEcu_sinkFill = 0;
+    SimEcu_sinkTime = SimEcu_now;
+    return E_OK;
+}
+
+/**
+ * @brief Drains the sink up to the current time
+ *
+ */
+static void SimEcu_TpDrain(void)
+{
+    unsigned long long drained;
+    if(SimEcu_sinkRate)
+    {
+        drained = (SimEcu_now - SimEcu_sinkTime) * SimEcu_sinkRate / SIM_ECU_CLOCK_HZ;
+        SimEcu_sinkTime += drained * SIM_ECU_CLOCK_HZ / SimEcu_sinkRate;
+        SimEcu_sinkFill = (drained < SimEcu_sinkFill) ? SimEcu_sinkFill - (unsigned long)drained : 0;
+        if(!SimEcu_sinkFill)
+        {
+            SimEcu_sinkTime = SimEcu_now;
+        }
+    }
+}
+
+/**
+ * @brief Takes a received piece into the sink and checks it against the counting pattern
+ *
+ * @param data The piece
+ * @param length The length of the piece, 0 only asks for the room
+ * @param available Save the room of the sink in
+ * @return Std_ReturnType
+ *                  E_OK If the piece is taken
+ *                  E_NOT_OK If it does not fit in the sink
+ */
+static Std_ReturnType SimEcu_TpRxCopy(const uint8_t* data, uint8_t length, uint16_t* available)
+{
+    Std_ReturnType error = E_OK;
+    uint8_t i;
+    SimEcu_TpDrain();
+    if(SimEcu_sinkRate && SimEcu_sinkFill + length > SimEcu_sinkSize)
+    {
+        SimEcu_tp.rxRefused++;
+        error = E_NOT_OK;
+    }
+    else
+    {
+        for(i=0; i<length; i++)
+        {
+            SimEcu_tp.rxWrong += (data[i] != SimEcu_TpByte(SimEcu_tpRxOffset++));
+        }
+        SimEcu_tp.rxBytes += length;
+        SimEcu_sinkFill += SimEcu_sinkRate ? length : 0;
+    }
+    *available = SimEcu_sinkRate ? (uint16_t)(SimEcu_sinkSize - SimEcu_sinkFill) : SIM_TP_SINK_UNLIMITED;
+    return error;
+}
+
+/**
+ * @brief Counts the end of a reception, a message with a wrong byte is not whole
+ *
+ * @param result The result of the reception
+ */
+static void SimEcu_TpRxIndication(Std_ReturnType result)
+{
+    if(result == E_OK && SimEcu_tpRxOffset == SimEcu_tpRxLength && SimEcu_tp.rxWrong == SimEcu_tpRxWrong)
+    {
+        SimEcu_tp.rxDone++;
+    }
+    else
+    {
+        SimEcu_tp.rxAborted++;
+    }
+    SimEcu_tp.rxEnd = SimEcu_now;
+}
+
+/**
+ * @brief Starts the image at a time like main does
+ *
+ * @param time The time
+ */
+static void SimEcu_Start(simTime_t time)
+{
+    SimEcu_now = time;
+    SimEcu_origin = time;
+    SimEcu_synced = time;
+    GpioHost_Advance(0);
+    Tp_SetTxCopyCb(SimEcu_TpTxCopy);
+    Tp_SetTxConfirmationCb(SimEcu_TpTxConfirmation);
+    Tp_SetRxStartCb(SimEcu_TpRxStart);
+    Tp_SetRxCopyCb(SimEcu_TpRxCopy);
+    Tp_SetRxIndicationCb(SimEcu_TpRxIndication);
+    Sched_Init();
+    SimEcu_Service();
+}
+
+/**
+ * @brief Gets the time of the next thing the image does on its own
+ *
+ * @return simTime_t The time or SIM_ECU_NO_EVENT
+ */
+static simTime_t SimEcu_NextEvent(void)
+{
+    uint8_t i;
+    simTime_t next = SimEcu_txEnd;
+    simTime_t time;
+    unsigned long toggleUs;
+    for(i=0; i<SIM_NUMBER_OF_TIMERS; i++)
+    {
+        time = SimEcu_TimerEvent(&SimEcu_timer[i]);
+        next = (time < next) ? time : next;
+    }
+    if(GpioHost_NextToggle(&toggleUs))
+    {
+        time = SimEcu_origin + (simTime_t)toggleUs * SIM_ECU_CYCLES_PER_US;
+        next = (time < next) ? time : next;
+    }
+    return next;
+}
+
+/**
+ * @brief Runs the interrupts and the tasks of the image up to a time
+ *
+ * @param time The time
+ */
+static void SimEcu_Run(simTime_t time)
+{
+    simTime_t next = SimEcu_NextEvent();
+    while(next <= time)
+    {
+        SimEcu_now = next;
+        SimEcu_SyncTimers();
+        GpioHost_Advance(SIM_PIN_TIME(next));
+        if(SimEcu_txEnd == next)
+        {
+            SimEcu_txEnd = SIM_ECU_NO_EVENT;
+            SimEcu_txComplete = 1;
+        }
+        SimEcu_Service();
+        next = SimEcu_NextEvent();
+    }
+    SimEcu_now = time;
+    SimEcu_SyncTimers();
+    GpioHost_Advance(SIM_PIN_TIME(time));
+}
+
+/**
+ * @brief Drives input pins at the current time of the image
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins
+ * @param levels The levels driven on the pins
+ */
+static void SimEcu_Drive(unsigned char port, unsigned char pins, unsigned char levels)
+{
+    GpioHost_Drive(port, pins, levels);
+    SimEcu_Service();
+}
+
+/**
+ * @brief Drives a bouncing contact from the current time of the image, see GpioHost_Bounce
+ *
+ * @param port The base address of the port (GPIO_PORTX)
+ * @param pins The driven pins
+ * @param levels The levels the pins settle on
+ * @param bounces The number of times the pins go back to the old levels
+ * @param intervalUs The time between two toggles
+ */
+static void SimEcu_Bounce(unsigned char port, unsigned char pins, unsigned char levels, unsigned int bounces,
+                          unsigned long intervalUs)
+{
+    GpioHost_Bounce(port, pins, levels, bounces, intervalUs);
+    SimEcu_Service();
+}
+
+/**
+ * @brief Gets the task of the switch driver
+ *
+ * @param interrupt Save 1 in if the switches are watched with interrupts
+ * @return int The index of the task in Sched_sysTaskInfo, which is the id of its trace, -1 if it is not scheduled
+ */
+static int SimEcu_GetSwitchTask(int* interrupt)
+{
+    int task = -1;
+    uint8_t i;
+    for(i=0; i<SCHED_NUMBER_OF_TASKS; i++)
+    {
+        if(Sched_sysTaskInfo[i].task == &Switch_task)
+        {
+            task = i;
+        }
+    }
+    *interrupt = SIM_SWITCH_INTERRUPT;
+    return task;
+}
+
+/**
+ * @brief Gets the port and the pin of a switch
+ *
+ * @param switchName The name of the switch
+ * @param port Save the base address of its port in
+ * @param pin Save its pin in
+ * @return int 1 if the switch exists
+ */
+static int SimEcu_GetSwitch(unsigned char switchName, unsigned char* port, unsigned char* pin)
+{
+    int found = 0;
+    if(switchName < SWITCH_NUMBER_OF_SWITCHES)
+    {
+        *port = (unsigned char)Switch_switches[switchName].port;
+        *pin = (unsigned char)Switch_switches[switchName].pin;
+        found = 1;
+    }
+    return found;
+}
+
+/**
+ * @brief Delivers a byte at the current time of the image
+ *        A byte sent at another bit time or format than the receiver is taken as a framing error,
+ *        a byte arriving before the handler took the last one is an overrun
+ *
+ * @param byte The byte
+ * @param errors The SIM_ECU_ errors of the line
+ * @param frameCycles The frame time of the sender
+ * @param format The UCSRC of the sender
+ */
+static void SimEcu_Receive(unsigned char byte, unsigned char errors, simTime_t frameCycles, unsigned char format)
+{
+    simTime_t own = SimEcu_FrameCycles();
+    simTime_t difference = (frameCycles > own) ? frameCycles - own : own - frameCycles;
+    if(Sim_registers[SIM_UCSRB] & SIM_RX_EN)
+    {
+        if(difference * 1000 > own * SIM_UART_TOLERANCE ||
+           ((format ^ Sim_registers[SIM_UCSRC]) & (SIM_PARITY | SIM_TWO_STOP_BITS)))
+        {
+            errors |= SIM_ECU_FRAMING_ERROR;
+        }
+        Sim_registers[SIM_UCSRA] = SIM_RXC | errors | (SimEcu_rxFull ? SIM_DATA_OVERRUN : 0);
+        Sim_registers[SIM_UDR] = byte;
+        SimEcu_rxFull = 1;
+        SimEcu_Service();
+    }
+}
+
+/**
+ * @brief Sets the function called for every byte the UART sends
+ *
+ * @param hook The function
+ * @param context Its context
+ */
+static void SimEcu_SetTxHook(simTxHook_t hook, void* context)
+{
+    SimEcu_txHook = hook;
+    SimEcu_txContext = context;
+}
+
+/**
+ * @brief Runs the UART at a baud rate instead of the one of UBRR
+ *
+ * @param baud The baud rate, 0 for the one of UBRR
+ */
+static void SimEcu_SetBaud(unsigned long baud)
+{
+    SimEcu_baud = baud;
+}
+
+/**
+ * @brief Takes the oldest trace record
+ *
+ * @param record Save the record in
+ * @return int 1 if a record is returned
+ */
+static int SimEcu_ReadTrace(simTrace_t* record)
+{
+    int found = 0;
+    if(SimEcu_traceCount)
+    {
+        *record = SimEcu_trace[SimEcu_traceHead];
+        SimEcu_traceHead = (SimEcu_traceHead + 1) % SIM_TRACE_SIZE;
+        SimEcu_traceCount--;
+        found = 1;
+    }
+    return found;
+}
+
+/**
+ * @brief Gets the number of trace records lost because they were not taken in time
+ *
+ * @return unsigned long The lost records
+ */
+static unsigned long SimEcu_GetTraceLost(void)
+{
+    return SimEcu_traceLost;
+}
+
+/**
+ * @brief Gets the counters of the UART driver
+ *
+ * @param stats Save the counters in
+ */
+static void SimEcu_GetUartStats(simUartStats_t* stats)
+{
+    uartStats_t uartStats;
+    Uart_GetStats(&uartStats);
+    stats->txBytes = uartStats.txBytes;
+    stats->rxBytes = uartStats.rxBytes;
+    stats->overrunErrors = uartStats.overrunErrors;
+    stats->framingErrors = uartStats.framingErrors;
+    stats->parityErrors = uartStats.parityErrors;
+    stats->discardedFrames = uartStats.discardedFrames;
+}
+
+/**
+ * @brief Starts sending a message of the counting pattern through the Transport Protocol
+ *
+ * @param length The length of the message
+ * @return int 1 if the transmission is started
+ */
+static int SimEcu_TpTransmit(unsigned int length)
+{
+    int started = 0;
+    if(SIM_TP_LINK && length <= TP_MAX_MESSAGE_LENGTH && Tp_Transmit((uint16_t)length) == E_OK)
+    {
+        SimEcu_tpTxOffset = 0;
+        started = 1;
+    }
+    return started;
+}
+
+/**
+ * @brief Sets the sink of the received messages
+ *
+ * @param rate The bytes drained per second, 0 takes every piece at once
+ * @param size The bytes the sink holds
+ */
+static void SimEcu_SetTpSink(unsigned long rate, unsigned long size)
+{
+    SimEcu_sinkRate = rate;
+    SimEcu_sinkSize = (size < SIM_TP_SINK_UNLIMITED) ? size : SIM_TP_SINK_UNLIMITED;
+}
+
+/**
+ * @brief Gets the counters of the user of the Transport Protocol
+ *
+ * @param stats Save the counters in
+ */
+static void SimEcu_GetTpStats(simTpStats_t* stats)
+{
+    *stats = SimEcu_tp;
+}
+
+/**
+ * @brief Takes a byte the UART driver writes to UDR
+ *        The byte starts when the line is free and the transmission complete handler runs at its end
+ *
+ * @param byte The byte
+ */
+void SimEcu_UartWrite(unsigned char byte)
+{
+    simTime_t start = SimEcu_now;
+    simTime_t frameCycles = SimEcu_FrameCycles();
+    Sim_registers[SIM_UDR] = byte;
+    if(Sim_registers[SIM_UCSRB] & SIM_TX_EN)
+    {
+        if(SimEcu_txEnd != SIM_ECU_NO_EVENT && SimEcu_txEnd > start)
+        {
+            start = SimEcu_txEnd;
+        }
+        SimEcu_txEnd = start + frameCycles;
+        if(SimEcu_txHook)
+        {
+            SimEcu_txHook(SimEcu_txContext, byte, start, frameCycles, Sim_registers[SIM_UCSRC]);
+        }
+    }
+}
+
+const simEcu_t SimEcu_interface = {
+    SimEcu_Start,
+    SimEcu_NextEvent,
+    SimEcu_Run,
+    SimEcu_Drive,
+    SimEcu_Bounce,
+    GpioHost_GetOutputs,
+    SimEcu_GetSwitch,
+    SimEcu_GetSwitchTask,
+    SimEcu_Receive,
+    SimEcu_SetTxHook,
+    SimEcu_SetBaud,
+    SimEcu_ReadTrace,
+    SimEcu_GetTraceLost,
+    SimEcu_GetUartStats,
+    SimEcu_TpTransmit,
+    SimEcu_SetTpSink,
+    SimEcu_GetTpStats
+};
@@ -0,0 +1,137 @@
+/**
+ * @file SimEcu.h
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the interface of an ECU image of the host simulation
+ *        An ECU is built with HOST_SIM and GPIO_HOST_BACKEND into a shared object together with SimEcu.c,
+ *        which plays Timer0, Timer2, the UART and the pins of the ATMEGA32 on the register file of the image.
+ *        Sim.c loads two images side by side, each one keeps its own globals and registers,
+ *        and connects their UARTs through a virtual wire
+ *        In the builds with UART_LINK_TP it also plays the user of the Transport Protocol,
+ *        which sends and checks messages of a counting pattern
+ *        It only uses plain C types so it can be included next to the system headers
+ * @version 0.1
+ * @date 2020-05-02
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#ifndef SIM_ECU_H
+#define SIM_ECU_H
+
+/* The CPU clock of both ECUs, the simulated time counts its cycles */
+#define SIM_ECU_CLOCK_HZ                8000000ULL
+#define SIM_ECU_CYCLES_PER_US           (SIM_ECU_CLOCK_HZ / 1000000ULL)
+
+/* The flags of UCSRA a received byte can carry */
+#define SIM_ECU_FRAMING_ERROR           0x10
+#define SIM_ECU_PARITY_ERROR            0x04
+
+/* The name of the interface in the shared object of an image */
+#define SIM_ECU_INTERFACE               "SimEcu_interface"
+
+#define SIM_ECU_NO_EVENT                (~0ULL)
+
+/* A time in cycles of SIM_ECU_CLOCK_HZ */
+typedef unsigned long long simTime_t;
+
+/**
+ * @brief Called when the UART of an image starts sending a byte
+ *
+ * @param context The context given to setTxHook
+ * @param byte The byte
+ * @param start The time of the start bit
+ * @param frameCycles The time of the whole frame from the start bit to the end of the stop bits
+ * @param format The UCSRC of the sender (parity and stop bits)
+ */
+typedef void (*simTxHook_t)(void* context, unsigned char byte, simTime_t start, simTime_t frameCycles,
+                            unsigned char format);
+
+/* A trace record of the image with its time in micro seconds of the Timer0 timebase */
+typedef struct
+{
+    unsigned char event;
+    unsigned char id;
+    unsigned char data;
+    unsigned long timeUs;
+} simTrace_t;
+
+/* The UART counters of the image */
+typedef struct
+{
+    unsigned long txBytes;
+    unsigned long rxBytes;
+    unsigned long overrunErrors;
+    unsigned long framingErrors;
+    unsigned long parityErrors;
+    unsigned long discardedFrames;
+} simUartStats_t;
+
+/* The counters of the user of the Transport Protocol of the image */
+typedef struct
+{
+    unsigned long txDone;           /* The messages confirmed with E_OK */
+    unsigned long txAborted;        /* The messages confirmed with E_NOT_OK */
+    unsigned long txEarly;          /* The messages confirmed with E_OK while the UART was still sending */
+    unsigned long rxStarted;        /* The messages started to be received */
+    unsigned long rxDone;           /* The messages received whole and right */
+    unsigned long rxAborted;        /* The messages ended with E_NOT_OK, short or with a wrong byte */
+    unsigned long rxBytes;          /* The bytes taken */
+    unsigned long rxRefused;        /* The pieces refused because the sink was full */
+    unsigned long rxWrong;          /* The bytes taken that are not the counting pattern */
+    simTime_t txEnd;                /* The time of the last confirmation */
+    simTime_t rxEnd;                /* The time of the last indication */
+} simTpStats_t;
+
+typedef struct
+{
+    /* Starts the image at a time like main does, the Timer0 timebase counts from it */
+    void (*start)(simTime_t time);
+    /* Gets the time of the next thing the image does on its own, SIM_ECU_NO_EVENT if nothing */
+    simTime_t (*nextEvent)(void);
+    /* Runs the interrupts and the tasks of the image up to a time */
+    void (*run)(simTime_t time);
+    /* Drives input pins at the current time of the image, see GpioHost_Drive */
+    void (*drive)(unsigned char port, unsigned char pins, unsigned char levels);
+    /* Drives a bouncing contact from the current time of the image, see GpioHost_Bounce */
+    void (*bounce)(unsigned char port, unsigned char pins, unsigned char levels, unsigned int bounces,
+                   unsigned long intervalUs);
+    /* Gets the levels of the output pins of a port */
+    unsigned char (*getOutputs)(unsigned char port);
+    /* Gets the port and the pin of a switch of Switch_Cfg.c, 0 if there is no such switch */
+    int (*getSwitch)(unsigned char switchName, unsigned char* port, unsigned char* pin);
+    /* Gets the id of the switch task in the trace, -1 if it is not scheduled,
+       and if the switches are watched with interrupts */
+    int (*getSwitchTask)(int* interrupt);
+    /* Delivers a byte whose stop bit ended at the current time of the image
+       with the frame time and format of the sender and the SIM_ECU_ errors of the line */
+    void (*receive)(unsigned char byte, unsigned char errors, simTime_t frameCycles, unsigned char format);
+    /* Sets the function called for every byte the UART sends */
+    void (*setTxHook)(simTxHook_t hook, void* context);
+    /* Runs the UART at a baud rate instead of the one of UBRR, 0 goes back to UBRR */
+    void (*setBaud)(unsigned long baud);
+    /* Takes the oldest trace record not taken yet, returns 0 if there is none */
+    int (*readTrace)(simTrace_t* record);
+    /* Gets the number of trace records lost because they were not taken in time */
+    unsigned long (*getTraceLost)(void);
+    /* Gets the counters of the UART driver */
+    void (*getUartStats)(simUartStats_t* stats);
+    /* Starts sending a message of a counting pattern through the Transport Protocol,
+       returns 0 if the image is not built with UART_LINK_TP or the Tp is busy */
+    int (*tpTransmit)(unsigned int length);
+    /* Puts the received messages in a sink of size bytes drained at rate bytes per second, a rate of 0 takes them at once */
+    void (*setTpSink)(unsigned long rate, unsigned long size);
+    /* Gets the counters of the user of the Transport Protocol */
+    void (*getTpStats)(simTpStats_t* stats);
+} simEcu_t;
+
+extern const simEcu_t SimEcu_interface;
+
+/**
+ * @brief Takes a byte the UART driver writes to UDR
+ *        Uart.c calls it in HOST_SIM builds without UART_HOST_BACKEND
+ *
+ * @param byte The byte
+ */
+extern void SimEcu_UartWrite(unsigned char byte);
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file UartHostLoop.c
+ * @author Mark Attia (markjosephattia@gmail.com)
+ * @brief This is the loopback check of the socket backend of the UART driver
+ *        build.sh builds Uart.c and UartHost.c with HOST_SIM and UART_HOST_BACKEND into sim-uarthost
+ *        The UART listens on a UNIX socket and the check connects to it as the peer that echoes every byte,
+ *        the driver sends frames of a counting pattern and receives them back with the interrupts UartHost_Poll delivers
+ *        It checks that every frame comes back unchanged, that no byte is dropped and that the hang up
+ *        of the peer is reported, and exits with 1 when one does not
+ *        usage: sim-uarthost [path of the socket]
+ * @version 0.1
+ * @date 2020-05-03
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "Std_Types.h"
+#include "Reg_Access.h"
+#include "Uart.h"
+#include "UartHost.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define LOOP_BAUD_RATE              9600
+#define LOOP_FRAMES                 64
+#define LOOP_FRAME_SIZE             200
+#define LOOP_ECHO_CHUNK             64
+/* The polls of 1 ms a frame or the hang up may take before it is taken as lost */
+#define LOOP_POLLS                  1000
+#define LOOP_POLL_MS                1
+
+volatile uint8_t Sim_registers[REG_FILE_SIZE];
+
+static volatile uint8_t Loop_txDone;
+static volatile uint8_t Loop_rxDone;
+
+/**
+ * @brief Called by the driver when a frame is sent
+ *
+ */
+static void Loop_TxDone(void)
+{
+  Loop_txDone = 1;
+}
+
+/**
+ * @brief Called by the driver when a frame is received
+ *
+ */
+static void Loop_RxDone(void)
+{
+  Loop_rxDone = 1;
+}
+
+/**
+ * @brief Connects the peer to the socket the UART listens on
+ *
+ * @param path The path of the socket
+ * @return int The socket of the peer or -1
+ */
+static int Loop_Connect(const char* path)
+{
+  struct sockaddr_un addr;
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+  if (fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+  {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+/**
+ * @brief Sends back the bytes the peer received from the UART
+ *
+ * @param peer The socket of the peer
+ */
+static void Loop_Echo(int peer)
+{
+  unsigned char chunk[LOOP_ECHO_CHUNK];
+  ssize_t received = recv(peer, chunk, sizeof(chunk), MSG_DONTWAIT);
+  if (received > 0)
+  {
+    send(peer, chunk, (size_t)received, 0);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+  uint8_t tx[LOOP_FRAME_SIZE];
+  uint8_t rx[LOOP_FRAME_SIZE];
+  unsigned int frame;
+  unsigned int itr;
+  unsigned int wrong = 0;
+  int hungUp = 0;
+  int peer;
+  if (argc > 1)
+  {
+    snprintf(path, sizeof(path), "%s", argv[1]);
+  }
+  else
+  {
+    snprintf(path, sizeof(path), "/tmp/sim-uarthost-%d.sock", (int)getpid());
+  }
+  if (UartHost_Open(UART_HOST_SOCKET_LISTEN, path) != UART_HOST_OK || (peer = Loop_Connect(path)) < 0)
+  {
+    fprintf(stderr, "sim-uarthost: cannot open the socket %s\n", path);
+    UartHost_Close();
+    return 1;
+  }
+  /* The connection is accepted by the first poll */
+  UartHost_Poll(LOOP_POLL_MS);
+  Uart_Init(LOOP_BAUD_RATE, UART_ONE_STOP_BIT, UART_NO_PARITY);
+  Uart_SetTxCb(Loop_TxDone);
+  Uart_SetRxCb(Loop_RxDone);
+  for (frame = 0; frame < LOOP_FRAMES; frame++)
+  {
+    for (itr = 0; itr < LOOP_FRAME_SIZE; itr++)
+    {
+      tx[itr] = (uint8_t)(frame * LOOP_FRAME_SIZE + itr);
+    }
+    memset(rx, 0, sizeof(rx));
+    Loop_txDone = 0;
+    Loop_rxDone = 0;
+    Uart_Receive(rx, LOOP_FRAME_SIZE);
+    Uart_Send(tx, LOOP_FRAME_SIZE);
+    for (itr = 0; itr < LOOP_POLLS && !(Loop_txDone && Loop_rxDone); itr++)
+    {
+      UartHost_Poll(LOOP_POLL_MS);
+      Loop_Echo(peer);
+    }
+    wrong += (!Loop_txDone || !Loop_rxDone || memcmp(tx, rx, sizeof(tx)) != 0);
+  }
+  close(peer);
+  for (itr = 0; itr < LOOP_POLLS && !hungUp; itr++)
+  {
+    hungUp = (UartHost_Poll(LOOP_POLL_MS) == UART_HOST_HUNG_UP);
+  }
+  printf("%u frames of %u bytes echoed over %s, %u wrong, %lu bytes dropped, the hang up was %s\n", LOOP_FRAMES,
+         LOOP_FRAME_SIZE, path, wrong, UartHost_GetDroppedBytes(), hungUp ? "seen" : "not seen");
+  UartHost_Close();
+  unlink(path);
+  return wrong || UartHost_GetDroppedBytes() || !hungUp;
+}
@@ -0,0 +1,41 @@
+#!/bin/bash
+# Builds the host simulation of the door and the dimmer ECUs
+# usage: SIM/build.sh [output directory] [extra CFLAGS of both images]
+# The images are built from every source of the tree but main.c and the socket backend of the UART,
+# each one into its own shared object so the two ECUs keep separate globals and register files
+# It also builds the Led benchmark ledbench-<Leds> for 1 to 16 Leds from SIM/LedBench
+# and sim-uarthost, the loopback check of the socket backend of the UART (UartHost.c)
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-"$ROOT/SIM/out"}
+[ $# -gt 0 ] && shift
+EXTRA=("$@")
+CC=${CC:-gcc}
+read -r -a FLAGS <<< "${CFLAGS:-"-O2 -g -Wall -Wno-attributes"}"
+
+INCLUDES=()
+while IFS= read -r dir; do INCLUDES+=("-I$dir"); done < <(find "$ROOT" -name '*.h' -not -path '*/.git/*' -not -path '*/SIM/LedBench/*' \
+                                                         -exec dirname {} \; | sort -u)
+SOURCES=()
+while IFS= read -r file; do SOURCES+=("$file"); done < <(find "$ROOT/APPLICATION" "$ROOT/BSW" "$ROOT/RTE" -name '*.c' \
+                                                         -not -name 'main.c' -not -name 'UartHost.c' | sort)
+
+mkdir -p "$OUT"
+for image in door dimmer; do
+    DEFINES=(-DHOST_SIM -DGPIO_HOST_BACKEND -DTRACE_BUFFER_SIZE=128)
+    [ "$image" = door ] && DEFINES+=(-DFIRST_CONTROLLER_APP)
+    "$CC" "${FLAGS[@]}" -std=gnu99 -fPIC -shared -Wl,-Bsymbolic "${DEFINES[@]}" "${EXTRA[@]}" "${INCLUDES[@]}" \
+        "${SOURCES[@]}" "$ROOT/SIM/SimEcu.c" -o "$OUT/$image.so"
+done
+"$CC" "${FLAGS[@]}" -std=gnu99 -I"$ROOT/SIM" "$ROOT/SIM/Sim.c" -o "$OUT/sim" -ldl
+# The benchmark includes its Led_Cfg.h first, its guard leaves out the one of the dimmer
+for leds in 1 2 4 8 16; do
+    "$CC" "${FLAGS[@]}" -std=gnu99 -DHOST_SIM -DLED_BENCH_LEDS=$leds "${EXTRA[@]}" -include "$ROOT/SIM/LedBench/Led_Cfg.h" "${INCLUDES[@]}" \
+        "$ROOT/SIM/LedBench/LedBench.c" "$ROOT/SIM/LedBench/Led_Cfg.c" "$ROOT/BSW/Complex Drivers/Led/Led.c" \
+        "$ROOT/BSW/OS/Timer/Timer2.c" "$ROOT/BSW/MCAL/Gpio/Gpio.c" -Wl,--wrap=Gpio_WritePortMasked -o "$OUT/ledbench-$leds"
+done
+# The UART alone with its socket backend, the loopback check is the peer on the socket
+"$CC" "${FLAGS[@]}" -std=gnu99 -DHOST_SIM -DUART_HOST_BACKEND "${EXTRA[@]}" "${INCLUDES[@]}" "$ROOT/SIM/UartHostLoop.c" \
+    "$ROOT/BSW/COM/Uart.c" "$ROOT/BSW/COM/UartHost.c" -o "$OUT/sim-uarthost"
+echo "built $OUT/sim $OUT/door.so $OUT/dimmer.so $OUT/ledbench-* $OUT/sim-uarthost"
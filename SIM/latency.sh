@@ -0,0 +1,37 @@
+#!/bin/bash
+# Measures the door to lamp latency of the host simulation for several configurations of the Com, the RTE and the switches
+# usage: SIM/latency.sh [output directory] [options of sim]
+# Every configuration is built by build.sh into its own directory and runs the latency scenario,
+# it prints the p50, p99 and max of the door to lamp latency of each one and fails if one lost a door opening
+# The scheduler tick stays at SCHED_TICK_TIME_MS, every period of the configurations is a multiple of it
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-"$ROOT/SIM/out/latency"}
+[ $# -gt 0 ] && shift
+OPTIONS=("$@")
+
+# name|extra CFLAGS of both images
+CONFIGS=(
+    "default|"
+    "RTE Fast task 5 ms|-DRTE_FAST_TASK_PERIOD_MS=5"
+    "RTE Fast task 20 ms|-DRTE_FAST_TASK_PERIOD_MS=20"
+    "RTE server task 10 ms|-DRTE_SERVER_TASK_PERIOD_MS=10"
+    "door Pdu 20 ms|-DCOM_DOOR_PDU_PERIOD_MS=20"
+    "Com task and door Pdu 10 ms|-DCOM_TICK_TIME=10 -DCOM_DOOR_PDU_PERIOD_MS=10"
+    "switch interrupts|-DSWITCH_DETECTION=SWITCH_DETECTION_INTERRUPT"
+)
+
+failed=0
+printf "%-30s %10s %10s %10s\n" "configuration" "p50 ms" "p99 ms" "max ms"
+for config in "${CONFIGS[@]}"; do
+    name=${config%%|*}
+    read -r -a flags <<< "${config#*|}"
+    dir="$OUT/$(echo "$name" | tr ' ' '_')"
+    "$ROOT/SIM/build.sh" "$dir" "${flags[@]}" > /dev/null
+    if ! result=$("$dir/sim" --scenario latency "${OPTIONS[@]}"); then
+        failed=1
+    fi
+    echo "$result" | awk -v name="$name" '/^door->lamp/ { printf "%-30s %10s %10s %10s\n", name, $3, $6, $9 }'
+done
+exit $failed
@@ -0,0 +1,43 @@
+#!/bin/bash
+# Measures the throughput of the Transport Protocol of the host simulation at several block sizes
+# usage: SIM/tp.sh [output directory] [options of sim]
+# Every block size is built by build.sh with UART_LINK_TP into its own directory and runs the tp scenario
+# with 10 messages of 4095 bytes, once with a dimmer that takes the data at once and once with a sink of 128 bytes
+# drained at 100 B/s, slower than the line, so the dimmer makes the door wait while a block does not fit yet.
+# It prints the throughput, the p50 transfer time and the flow controls per message of each one and fails if a message was lost
+# Without blocks the whole message has to fit in the sink, so the slow sink is only run with blocks
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-"$ROOT/SIM/out/tp"}
+[ $# -gt 0 ] && shift
+OPTIONS=("$@")
+
+BLOCK_SIZES=(0 1 2 4 8 16)
+# name|options of sim
+SINKS=(
+    "all at once|"
+    "100 B/s|--sink 100 --sink-size 128"
+)
+
+failed=0
+printf "%-12s %-12s %12s %12s %14s\n" "block size" "sink" "B/s" "p50 ms" "flow controls"
+for blockSize in "${BLOCK_SIZES[@]}"; do
+    dir="$OUT/bs$blockSize"
+    "$ROOT/SIM/build.sh" "$dir" -DUART_LINK=UART_LINK_TP -DTP_BLOCK_SIZE="$blockSize" > /dev/null
+    for sink in "${SINKS[@]}"; do
+        name=${sink%%|*}
+        read -r -a flags <<< "${sink#*|}"
+        [ "$blockSize" = 0 ] && [ ${#flags[@]} -gt 0 ] && continue
+        if ! result=$("$dir/sim" --scenario tp --runs 10 "${flags[@]}" "${OPTIONS[@]}"); then
+            failed=1
+        fi
+        echo "$result" | awk -v bs="$blockSize" -v name="$name" '
+            /^[0-9]+ messages of/ { messages = $1 }
+            /flow controls/ { fc = $(NF - 2) }
+            /^throughput/ { bps = $2 }
+            /^transfer/ { p50 = $3 }
+            END { printf "%-12s %-12s %12s %12s %14s\n", bs, name, bps, p50, fc / messages }'
+    done
+done
+exit $failed